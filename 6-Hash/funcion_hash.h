@@ -0,0 +1,27 @@
+#ifndef FUNCION_HASH_H
+#define FUNCION_HASH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Funcion de hash de las tablas de hash.c y hash_robin_hood.c: SipHash-1-3 con una clave
+ * de 128 bits que cada tabla elige al azar al crearse. Si las claves vienen de afuera,
+ * quien las elige puede armar muchas que caigan en el mismo balde si conoce la funcion;
+ * sin conocer la semilla no puede. Procesa la clave de a 8 bytes.
+ */
+
+typedef struct semilla_hash {
+    uint64_t k0;
+    uint64_t k1;
+} semilla_hash_t;
+
+// Llena la semilla con bytes de /dev/urandom. Si no se puede leer, la arma con la hora y
+// direcciones de memoria.
+void semilla_hash_aleatoria(semilla_hash_t* semilla);
+
+// Devuelve el hash de la cadena con la semilla recibida. Lee las palabras en el orden de
+// bytes de la maquina, asi que el resultado cambia entre arquitecturas (no se guarda).
+size_t funcion_hash(const char* clave, const semilla_hash_t* semilla);
+
+#endif  // FUNCION_HASH_H
@@ -1,56 +1,60 @@
 #define _POSIX_C_SOURCE 200809L
 #include "hash.h"
+#include "funcion_hash.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
-#include "lista.h"
+
+//Con -DHASH_ROBIN_HOOD se usa la implementacion de hash_robin_hood.c.
+#ifndef HASH_ROBIN_HOOD
 
 #define TAMANIO_INICIAL 60
 #define MAX_FACTOR_REDIM 2
-#define MIN_FACTOR_REDIM 0.3
+//Se achica cuando la carga baja de 3/10, comparando en enteros.
+#define MIN_CARGA_NUMERADOR 3
+#define MIN_CARGA_DENOMINADOR 10
 #define FACTOR_REDIM 2
+//Mientras hay una redimension en curso, cada operacion que modifica el hash mueve esta
+//cantidad de baldes de la tabla vieja a la nueva.
+#define BALDES_MIGRADOS_POR_OPERACION 4
 
 
 /*******************************************************************
  *                DEFINICION DE LOS TIPOS DE DATOS                 *
  ******************************************************************/
 
+//Cada balde es una cadena de items enlazados entre si, asi que buscar, insertar o borrar
+//una clave no necesita nodos ni iteradores aparte.
 typedef struct hash_item {  //Le cambiamos el nombre, antes era nodo_hash_t.
+    size_t hash;    //Resultado completo de funcion_hash, para no recalcularlo al migrar.
     char *clave;
     void *dato;
+    struct hash_item *siguiente;
 } hash_item_t;
 
+//Redimensionar no mueve todos los items de una vez: la tabla anterior queda en
+//'tabla_vieja' y sus baldes se pasan de a poco a 'tabla'. Los baldes viejos menores a
+//'migrados' ya estan vacios; una clave de los demas sigue en la tabla vieja.
 struct hash {
-    lista_t **tabla;
+    hash_item_t **tabla;
     size_t tamanio;
+    hash_item_t **tabla_vieja;  //NULL si no hay una redimension en curso.
+    size_t tamanio_viejo;
+    size_t migrados;
     size_t cantidad;
     hash_destruir_dato_t destruir_dato;
+    semilla_hash_t semilla;     //Clave de funcion_hash, elegida al azar en hash_crear.
 };
 
 struct hash_iter {
-    lista_iter_t *lista_iter;
-    size_t pos_actual;
-    size_t elem_recorridos;
+    hash_item_t *actual;
+    size_t pos_actual;  //Proximo balde a revisar, contando los de la tabla vieja despues de los de la actual.
     const hash_t *hash;
 };
 
 /*******************************************************************
 *                        FUNCIONES PRIVADAS                        *
 *******************************************************************/
-//Realiza el hashing sobre la clave. Devuelve un indice
-//ALGORITMO DE HASH BY DJB2
-
-size_t funcion_hash(const char *str) {
-    
-    size_t hash = 5381;
-    int c;
-    while ((c = *str++)) {
-        hash = ((hash << 5) + hash) + (size_t) c; /* hash * 33 + c */
-    }
-
-    return hash;
-}
-
 //Llama a la funcion destruir_dato y elimina y libera la memoria
 //del item pasado por parametro.
 void destruir(hash_item_t* item, hash_destruir_dato_t destruir_dato) {
@@ -64,77 +68,103 @@ void destruir(hash_item_t* item, hash_destruir_dato_t destruir_dato) {
     free(item);
 }
 
+//Devuelve el balde donde esta o iria una clave con ese resultado de funcion_hash: el de
+//la tabla vieja si todavia no se migro, o el de la tabla actual.
+hash_item_t **balde_de(const hash_t *hash, size_t valor_hash) {
+
+    if (hash->tabla_vieja != NULL) {
+        size_t indice_viejo = valor_hash % hash->tamanio_viejo;
+        if (indice_viejo >= hash->migrados) return &hash->tabla_vieja[indice_viejo];
+    }
+    return &hash->tabla[valor_hash % hash->tamanio];
+}
+
 //Pre: Hash fue creado
-//Post: Devuelve el iterador sobre la lista contenida en cada item, NULL en caso de que no se haya encontrado.
-lista_iter_t *busqueda_item_en_hash(const hash_t *hash, const char *clave) {
+//Post: Devuelve el enlace que apunta al item de la clave, o el enlace vacio del final de
+//su balde si la clave no esta, y deja en 'valor_hash' el resultado de funcion_hash.
+//Con el enlace se lee, se inserta o se borra sin volver a buscar.
+hash_item_t **busqueda_item_en_hash(const hash_t *hash, const char *clave, size_t *valor_hash) {
     
-    size_t indice_busqueda = funcion_hash(clave) % hash->tamanio;
-    lista_iter_t *iter = lista_iter_crear(hash->tabla[indice_busqueda]);
-    if (iter == NULL) return NULL;
-    while (!lista_iter_al_final(iter)) {
-        hash_item_t* item = lista_iter_ver_actual(iter);
-        if (strcmp(clave, item->clave) == 0) {
-            break;
-        }
-        lista_iter_avanzar(iter);
+    *valor_hash = funcion_hash(clave, &hash->semilla);
+    hash_item_t **enlace = balde_de(hash, *valor_hash);
+    while (*enlace != NULL && ((*enlace)->hash != *valor_hash || strcmp(clave, (*enlace)->clave) != 0)) {
+        enlace = &(*enlace)->siguiente;
     }
-	return iter;
+    return enlace;
 }
 
 //Recibe un par clave-valor y crea un item de hash con los datos recibidos
 //Post: Devuelve dicho item.
-hash_item_t *crear_item(const char *clave, void *dato) {
+hash_item_t *crear_item(const char *clave, size_t valor_hash, void *dato) {
 
     hash_item_t *item_nue = malloc(sizeof(hash_item_t));
     if (item_nue == NULL) return NULL;
     char* clave_aux = strdup(clave);
-    if(!clave_aux) return NULL;
+    if(!clave_aux) {
+        free(item_nue);
+        return NULL;
+    }
+    item_nue->hash = valor_hash;
     item_nue->clave = clave_aux;
     item_nue->dato = dato;
+    item_nue->siguiente = NULL;
     return item_nue;
 }
 
-//Encuentra la proxima lista que contiene al menos a un item de hash dentro
+//Avanza hasta el primer item del proximo balde no vacio, si no hay mas items en el actual.
 void encontrar_proxima_lista_no_vacia(hash_iter_t *hash_iter) {
 
-    while (lista_esta_vacia(hash_iter->hash->tabla[hash_iter->pos_actual]) && !hash_iter_al_final(hash_iter)) {
+    const hash_t *hash = hash_iter->hash;
+    while (hash_iter->actual == NULL && hash_iter->pos_actual < hash->tamanio + hash->tamanio_viejo) {
+        size_t pos = hash_iter->pos_actual;
+        hash_iter->actual = pos < hash->tamanio ? hash->tabla[pos] : hash->tabla_vieja[pos - hash->tamanio];
         hash_iter->pos_actual += 1;
     }
 }
 
-//Crea una arreglo de tamaño 'tamanio_tabla' de elementos del tipo lista_t**
-//Post: Devuelve dicha tabla, NULL en caso de que algun malloc haya fallado o el tamaño recibido sea 0
-lista_t** hash_crear_tabla(size_t tamanio_tabla) {
+//Crea una tabla de 'tamanio_tabla' baldes vacios
+//Post: Devuelve dicha tabla, NULL en caso de que el malloc haya fallado
+hash_item_t** hash_crear_tabla(size_t tamanio_tabla) {
     
-    lista_t **tabla = malloc(sizeof(lista_t*) * tamanio_tabla);
-    if (tabla == NULL) return NULL;
-    for (int i = 0; i < tamanio_tabla; i++) {
-        lista_t *lista_aux = lista_crear();
-        if (lista_aux == NULL) {
-            lista_destruir(tabla[i],NULL);
-            return NULL;
+    return calloc(tamanio_tabla, sizeof(hash_item_t*));
+}
+
+//Pasa a la tabla actual hasta 'baldes' baldes de la tabla vieja, usando el hash guardado
+//en cada item. Cuando no quedan baldes por migrar, libera la tabla vieja.
+void hash_migrar_baldes(hash_t *hash, size_t baldes) {
+
+    if (hash->tabla_vieja == NULL) return;
+    for (; baldes > 0 && hash->migrados < hash->tamanio_viejo; baldes--) {
+        hash_item_t **balde = &hash->tabla_vieja[hash->migrados++];
+        while (*balde != NULL) {
+            hash_item_t *item = *balde;
+            *balde = item->siguiente;
+            size_t indice = item->hash % hash->tamanio;
+            item->siguiente = hash->tabla[indice];
+            hash->tabla[indice] = item;
         }
-        tabla[i] = lista_aux;
     }
-    return tabla;
+    if (hash->migrados == hash->tamanio_viejo) {
+        free(hash->tabla_vieja);
+        hash->tabla_vieja = NULL;
+        hash->tamanio_viejo = 0;
+        hash->migrados = 0;
+    }
 }
 
 //Pre: Recibe un hash y un tamaño que tiene que ser mayor igual que el tamaño inicial
-//Post: La tabla correspondiente al hash recibido por parametro fue redimensionada a el tamaño recibido por parametro
+//Post: La tabla del hash pasa a tener el tamaño recibido por parametro. Los items se
+//mueven de a poco en las operaciones siguientes. Si todavia hay una redimension a medias
+//no hace nada: la operacion que encuentre la carga fuera de rango despues de que
+//termine la vuelve a pedir.
 bool hash_redimensionar(hash_t *hash, size_t nuevo_tamanio) {
     
-    lista_t **tabla_nueva = hash_crear_tabla(nuevo_tamanio);
+    if (hash->tabla_vieja != NULL) return true;
+    hash_item_t **tabla_nueva = hash_crear_tabla(nuevo_tamanio);
     if (tabla_nueva == NULL) return false;
-    for (int j = 0; j < hash->tamanio; j++) {
-        while (!lista_esta_vacia(hash->tabla[j])) {
-            hash_item_t *item = lista_borrar_primero(hash->tabla[j]);
-            size_t indice = funcion_hash(item->clave) % nuevo_tamanio;
-            lista_insertar_ultimo(tabla_nueva[indice],item);
-        }
-        
-        lista_destruir(hash->tabla[j], NULL);
-    }
-    free(hash->tabla);
+    hash->tabla_vieja = hash->tabla;
+    hash->tamanio_viejo = hash->tamanio;
+    hash->migrados = 0;
     hash->tabla = tabla_nueva;
     hash->tamanio = nuevo_tamanio;
     return true;
@@ -153,15 +183,19 @@ hash_t *hash_crear(hash_destruir_dato_t destruir_dato) {
     
     hash_t *hash = malloc(sizeof(hash_t));
     if (hash == NULL) return NULL;
-    lista_t** tabla = hash_crear_tabla(TAMANIO_INICIAL);
+    hash_item_t** tabla = hash_crear_tabla(TAMANIO_INICIAL);
     if (tabla == NULL) {
         free(hash);
         return NULL;
     }
     hash->tabla = tabla;
     hash->tamanio = TAMANIO_INICIAL;
+    hash->tabla_vieja = NULL;
+    hash->tamanio_viejo = 0;
+    hash->migrados = 0;
     hash->cantidad = 0;
     hash->destruir_dato = destruir_dato;
+    semilla_hash_aleatoria(&hash->semilla);
     return hash;
 }
 
@@ -171,45 +205,66 @@ hash_t *hash_crear(hash_destruir_dato_t destruir_dato) {
 //Post: devuelve un booleano segun la condicion del guardado.
 bool hash_guardar(hash_t *hash, const char *clave, void *dato) {
     
-    if (hash->cantidad/hash->tamanio >= MAX_FACTOR_REDIM) {
+    hash_migrar_baldes(hash, BALDES_MIGRADOS_POR_OPERACION);
+    if (hash->cantidad >= hash->tamanio * MAX_FACTOR_REDIM) {
         if(!hash_redimensionar(hash, hash->tamanio * FACTOR_REDIM)) return false;
     }
-    lista_iter_t* iter = busqueda_item_en_hash(hash, clave); //busco si existe el item en la tabla
-    if (lista_iter_ver_actual(iter)!=NULL) {
-    	hash_item_t* item_aux = lista_iter_ver_actual(iter); //DESTRUIR PORQUE HAY UNA LISTA EN ESA POSICION
-        if (hash->destruir_dato != NULL) hash->destruir_dato(item_aux->dato);
-        item_aux->dato = dato;
-    } else {
-        hash_item_t *item_a_insertar = crear_item(clave, dato);
-        if (item_a_insertar == NULL) return false;
-        // Tanto si la lista esta en la posicion esta vacia como si ya tiene
-        // elementos no hay diferencia, lista insertar se encarga de manejar
-        // la actualizacion de punteros y demas cosas
-        lista_iter_insertar(iter, item_a_insertar);
-        hash->cantidad++;
-        
+    size_t valor_hash;
+    hash_item_t **enlace = busqueda_item_en_hash(hash, clave, &valor_hash); //busco si existe el item en la tabla
+    if (*enlace != NULL) {
+        if (hash->destruir_dato != NULL) hash->destruir_dato((*enlace)->dato);
+        (*enlace)->dato = dato;
+        return true;
     }
-    lista_iter_destruir(iter);
+    // El enlace vacio es el del final del balde: el item nuevo queda ultimo.
+    hash_item_t *item_a_insertar = crear_item(clave, valor_hash, dato);
+    if (item_a_insertar == NULL) return false;
+    *enlace = item_a_insertar;
+    hash->cantidad++;
     return true;
 }
+//Busca la clave una sola vez y devuelve donde esta guardado su dato. Si no estaba,
+//la guarda con el dato que crea crear_dato.
+//Pre: el hash fue creado.
+//Post: devuelve la direccion del dato, NULL si no se pudo crear o guardar.
+void **hash_obtener_o_insertar(hash_t *hash, const char *clave, hash_crear_dato_t crear_dato, void *extra) {
+
+    hash_migrar_baldes(hash, BALDES_MIGRADOS_POR_OPERACION);
+    if (hash->cantidad >= hash->tamanio * MAX_FACTOR_REDIM) {
+        if(!hash_redimensionar(hash, hash->tamanio * FACTOR_REDIM)) return NULL;
+    }
+    size_t valor_hash;
+    hash_item_t **enlace = busqueda_item_en_hash(hash, clave, &valor_hash);
+    if (*enlace == NULL) {
+        void *dato = crear_dato(clave, extra);
+        if (dato == NULL) return NULL;
+        *enlace = crear_item(clave, valor_hash, dato);
+        if (*enlace == NULL) {
+            if (hash->destruir_dato != NULL) hash->destruir_dato(dato);
+            return NULL;
+        }
+        hash->cantidad++;
+    }
+    return &(*enlace)->dato;
+}
+
 //Busca el item en el hash y lo borra, devolviendo su dato.
 //Pre: el hash fue creado.
 //Post: se devuelve el dato del item borrado.
 void *hash_borrar(hash_t *hash, const char *clave) {
     
-    if (hash->cantidad/hash->tamanio <= MIN_FACTOR_REDIM && (hash->tamanio / FACTOR_REDIM) > TAMANIO_INICIAL) {
+    hash_migrar_baldes(hash, BALDES_MIGRADOS_POR_OPERACION);
+    if (hash->cantidad * MIN_CARGA_DENOMINADOR < hash->tamanio * MIN_CARGA_NUMERADOR && (hash->tamanio / FACTOR_REDIM) > TAMANIO_INICIAL) {
         if(!hash_redimensionar(hash, hash->tamanio / FACTOR_REDIM)) return NULL;
     }
-    lista_iter_t* iter = busqueda_item_en_hash(hash, clave);
-    void* dato;
-    if(lista_iter_al_final(iter)) dato = NULL;
-    else{
-    	hash_item_t* aux = lista_iter_borrar(iter);
-    	dato = aux->dato;
-    	destruir(aux,NULL);
-    	hash->cantidad--;
-    }
-    lista_iter_destruir(iter);
+    size_t valor_hash;
+    hash_item_t **enlace = busqueda_item_en_hash(hash, clave, &valor_hash);
+    if (*enlace == NULL) return NULL;
+    hash_item_t *aux = *enlace;
+    *enlace = aux->siguiente;
+    void* dato = aux->dato;
+    destruir(aux, NULL);
+    hash->cantidad--;
     return dato;
 }
 
@@ -219,10 +274,8 @@ void *hash_borrar(hash_t *hash, const char *clave) {
 //de la clave en el hash.
 bool hash_pertenece(const hash_t *hash, const char *clave) {
 
-	lista_iter_t* iter = busqueda_item_en_hash(hash,clave);
-	hash_item_t* item = lista_iter_ver_actual(iter);
-	lista_iter_destruir(iter);
-	return item!=NULL;
+	size_t valor_hash;
+	return *busqueda_item_en_hash(hash, clave, &valor_hash) != NULL;
 }
 
 //Devuelve el valor asociado a una clave.
@@ -231,12 +284,9 @@ bool hash_pertenece(const hash_t *hash, const char *clave) {
 //no existe.
 void *hash_obtener(const hash_t *hash, const char *clave) {
     
-    lista_iter_t* iter = busqueda_item_en_hash(hash, clave);
-    void* dato;
-    if(lista_iter_al_final(iter)) dato = NULL;
-    else dato = ((hash_item_t*)lista_iter_ver_actual(iter))->dato;
-    lista_iter_destruir(iter);
-    return dato;
+    size_t valor_hash;
+    hash_item_t *item = *busqueda_item_en_hash(hash, clave, &valor_hash);
+    return item != NULL ? item->dato : NULL;
 }
 
 //Devuelve la cantidad de elementos del hash.
@@ -253,12 +303,13 @@ size_t hash_cantidad(const hash_t *hash) {
 //Post: se destruyen los datos del hash y el hash.
 void hash_destruir(hash_t *hash) {
     
-    for (int i = 0; i < hash->tamanio; i++) {
-        while (!lista_esta_vacia(hash->tabla[i])) {
-            hash_item_t *item_aux = lista_borrar_primero(hash->tabla[i]);
+    hash_migrar_baldes(hash, hash->tamanio_viejo);
+    for (size_t i = 0; i < hash->tamanio; i++) {
+        while (hash->tabla[i] != NULL) {
+            hash_item_t *item_aux = hash->tabla[i];
+            hash->tabla[i] = item_aux->siguiente;
             destruir(item_aux, hash->destruir_dato);
         }
-        lista_destruir(hash->tabla[i],NULL);
     }
     free(hash->tabla);
     free(hash);
@@ -277,13 +328,8 @@ hash_iter_t *hash_iter_crear(const hash_t *hash) {
 
     iter->hash = hash;
     iter->pos_actual = 0;
-    iter->elem_recorridos = 0;
-    if (hash->cantidad == 0) {
-        iter->lista_iter = NULL;
-    } else {
-        encontrar_proxima_lista_no_vacia(iter);
-        iter->lista_iter = lista_iter_crear(hash->tabla[iter->pos_actual]);
-    }
+    iter->actual = NULL;
+    encontrar_proxima_lista_no_vacia(iter);
     return iter;
 }
 
@@ -293,7 +339,7 @@ hash_iter_t *hash_iter_crear(const hash_t *hash) {
 //false en caso contrario.
 bool hash_iter_al_final(const hash_iter_t *iter) {
     
-    return (iter->elem_recorridos == iter->hash->cantidad);
+    return iter->actual == NULL;
 }
 
 //Avanza a la siguiente posicion del hash.
@@ -302,19 +348,10 @@ bool hash_iter_al_final(const hash_iter_t *iter) {
 bool hash_iter_avanzar(hash_iter_t *iter) {
     
     if (hash_iter_al_final(iter)) return false;
-    if(!lista_iter_avanzar(iter->lista_iter)) return false;
-    iter->elem_recorridos++;
-    //Luego de avanzar puede quedar al final del hash el iterador
-    if (lista_iter_al_final(iter->lista_iter) && !hash_iter_al_final(iter)) {
-        lista_iter_destruir(iter->lista_iter);
-        iter->pos_actual++;
-        encontrar_proxima_lista_no_vacia(iter);
-        iter->lista_iter = lista_iter_crear(iter->hash->tabla[iter->pos_actual]);
-    }
-
+    iter->actual = iter->actual->siguiente;
+    //Si se termino el balde, se pasa al proximo que tenga items
+    encontrar_proxima_lista_no_vacia(iter);
     return true;
-
-
 }
 
 //Devuelve la clave donde esta posicionado el iter.
@@ -323,8 +360,7 @@ bool hash_iter_avanzar(hash_iter_t *iter) {
 const char *hash_iter_ver_actual(const hash_iter_t *iter) {
     
     if (hash_iter_al_final(iter)) return NULL;
-    hash_item_t *item_act = lista_iter_ver_actual(iter->lista_iter);
-    return item_act->clave;
+    return iter->actual->clave;
 }
 
 //Destruye el iterador.
@@ -332,8 +368,7 @@ const char *hash_iter_ver_actual(const hash_iter_t *iter) {
 //Post: destruye el iterador y libera la memoria.
 void hash_iter_destruir(hash_iter_t *iter) {
     
-    lista_iter_destruir(iter->lista_iter);
     free(iter);
 }
 
-
+#endif //HASH_ROBIN_HOOD
@@ -14,6 +14,10 @@ typedef struct hash_iter hash_iter_t;
 // tipo de función para destruir dato
 typedef void (*hash_destruir_dato_t)(void *);
 
+// tipo de función para crear el dato de una clave nueva en hash_obtener_o_insertar.
+// Recibe la clave y el 'extra' que se le paso; devuelve NULL si no pudo crearlo.
+typedef void *(*hash_crear_dato_t)(const char *clave, void *extra);
+
 /* Crea el hash
  */
 hash_t *hash_crear(hash_destruir_dato_t destruir_dato);
@@ -25,6 +29,15 @@ hash_t *hash_crear(hash_destruir_dato_t destruir_dato);
  */
 bool hash_guardar(hash_t *hash, const char *clave, void *dato);
 
+/* Busca la clave una sola vez y devuelve la direccion donde el hash guarda su
+ * dato, para leerlo o cambiarlo sin volver a buscarla. Si la clave no estaba, la
+ * guarda con el dato que devuelve crear_dato(clave, extra).
+ * Devuelve NULL si la clave no estaba y no se pudo crear el dato o guardarla.
+ * Pre: La estructura hash fue inicializada
+ * Post: La direccion sirve hasta la proxima vez que se guarde o borre en el hash.
+ */
+void **hash_obtener_o_insertar(hash_t *hash, const char *clave, hash_crear_dato_t crear_dato, void *extra);
+
 /* Borra un elemento del hash y devuelve el dato asociado.  Devuelve
  * NULL si el dato no estaba.
  * Pre: La estructura hash fue inicializada
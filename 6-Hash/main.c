@@ -9,6 +9,7 @@
 
 void pruebas_hash_catedra(void);
 void pruebas_volumen_catedra(size_t);
+void pruebas_hash_alumno(void);
 
 int main(int argc, char *argv[])
 {   
@@ -21,7 +22,9 @@ int main(int argc, char *argv[])
 
     printf("~~~ PRUEBAS CÁTEDRA ~~~\n");
     pruebas_hash_catedra();
-    
+
+    printf("~~~ PRUEBAS ALUMNO ~~~\n");
+    pruebas_hash_alumno();
 
     return failure_count() > 0;
 }
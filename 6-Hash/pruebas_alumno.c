@@ -0,0 +1,259 @@
+#include "hash.h"
+#include "funcion_hash.h"
+#include "testing.h"
+#include <stdio.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+/* ******************************************************************
+ *                   PRUEBAS UNITARIAS HASH ALUMNO
+ * *****************************************************************/
+
+/* Para contar las asignaciones de memoria el ejecutable se enlaza con
+ * -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc,--wrap=strdup (ver Makefile): las llamadas
+ * desde el codigo del hash, la lista y las pruebas pasan por estas funciones, que cuentan
+ * y delegan en las originales. Las que hace la libc por dentro (stdio) no se cuentan. */
+static size_t asignaciones = 0;
+void* __real_malloc(size_t tam);
+void* __real_calloc(size_t cantidad, size_t tam);
+void* __real_realloc(void* ptr, size_t tam);
+char* __real_strdup(const char* cadena);
+
+void* __wrap_malloc(size_t tam){
+	asignaciones++;
+	return __real_malloc(tam);
+}
+
+void* __wrap_calloc(size_t cantidad, size_t tam){
+	asignaciones++;
+	return __real_calloc(cantidad, tam);
+}
+
+void* __wrap_realloc(void* ptr, size_t tam){
+	asignaciones++;
+	return __real_realloc(ptr, tam);
+}
+
+char* __wrap_strdup(const char* cadena){
+	asignaciones++;
+	return __real_strdup(cadena);
+}
+
+//Crea un contador en 0 y cuenta cuantas veces se lo llamo en 'extra'.
+void* crear_contador(const char* clave, void* extra){
+	size_t* llamadas = extra;
+	if(llamadas) (*llamadas)++;
+	int* contador = malloc(sizeof(int));
+	if(contador) *contador = 0;
+	return contador;
+}
+
+//Simula una creacion que falla.
+void* crear_nada(const char* clave, void* extra){
+	return NULL;
+}
+
+void pruebas_obtener_o_insertar_clave_nueva(){
+	printf("### INICIO DE PRUEBAS OBTENER O INSERTAR CON CLAVE NUEVA ###\n");
+	hash_t* hash = hash_crear(free);
+	size_t llamadas = 0;
+	void** dato = hash_obtener_o_insertar(hash, "perro", crear_contador, &llamadas);
+	print_test("Obtener o insertar una clave nueva devuelve su dato", dato != NULL && *dato != NULL);
+	print_test("Se creo el dato una vez", llamadas == 1);
+	print_test("La cantidad de elementos es 1", hash_cantidad(hash) == 1);
+	print_test("La clave pertenece", hash_pertenece(hash, "perro"));
+	print_test("Obtener devuelve el dato creado", dato != NULL && hash_obtener(hash, "perro") == *dato);
+	print_test("El dato creado vale 0", dato != NULL && *(int*)*dato == 0);
+	hash_destruir(hash);
+	printf("\n");
+}
+
+void pruebas_obtener_o_insertar_clave_existente(){
+	printf("### INICIO DE PRUEBAS OBTENER O INSERTAR CON CLAVE EXISTENTE ###\n");
+	hash_t* hash = hash_crear(NULL);
+	char* valor1 = "guau";
+	char* valor2 = "miau";
+	size_t llamadas = 0;
+	print_test("Guardar una clave", hash_guardar(hash, "perro", valor1));
+	void** dato = hash_obtener_o_insertar(hash, "perro", crear_contador, &llamadas);
+	print_test("Obtener o insertar una clave existente devuelve su dato", dato != NULL && *dato == valor1);
+	print_test("No se creo ningun dato", llamadas == 0);
+	print_test("La cantidad de elementos sigue siendo 1", hash_cantidad(hash) == 1);
+	if(dato) *dato = valor2;
+	print_test("Cambiar el dato por la direccion lo cambia en el hash", hash_obtener(hash, "perro") == valor2);
+	hash_destruir(hash);
+	printf("\n");
+}
+
+void pruebas_obtener_o_insertar_sin_dato(){
+	printf("### INICIO DE PRUEBAS OBTENER O INSERTAR SIN PODER CREAR EL DATO ###\n");
+	hash_t* hash = hash_crear(NULL);
+	print_test("Si no se puede crear el dato devuelve NULL", hash_obtener_o_insertar(hash, "gato", crear_nada, NULL) == NULL);
+	print_test("La clave no pertenece", !hash_pertenece(hash, "gato"));
+	print_test("La cantidad de elementos es 0", hash_cantidad(hash) == 0);
+	hash_destruir(hash);
+	printf("\n");
+}
+
+void pruebas_obtener_o_insertar_copia_clave(){
+	printf("### INICIO DE PRUEBAS OBTENER O INSERTAR COPIA LA CLAVE ###\n");
+	hash_t* hash = hash_crear(free);
+	char clave[] = "vaca";
+	print_test("Obtener o insertar una clave nueva", hash_obtener_o_insertar(hash, clave, crear_contador, NULL) != NULL);
+	clave[0] = 'b';
+	print_test("Cambiar la clave original no cambia la guardada", hash_pertenece(hash, "vaca"));
+	print_test("La clave cambiada no pertenece", !hash_pertenece(hash, "baca"));
+	hash_destruir(hash);
+	printf("\n");
+}
+
+void pruebas_obtener_o_insertar_contadores(size_t largo){
+	printf("### INICIO DE PRUEBAS OBTENER O INSERTAR COMO CONTADOR ###\n");
+	hash_t* hash = hash_crear(free);
+	const size_t repeticiones = 3;
+	char clave[24];
+	size_t llamadas = 0;
+	bool ok = true;
+	for(size_t vuelta = 0; vuelta < repeticiones; vuelta++){
+		for(size_t i = 0; ok && i < largo; i++){
+			sprintf(clave, "%08zu", i);
+			void** contador = hash_obtener_o_insertar(hash, clave, crear_contador, &llamadas);
+			ok = contador != NULL;
+			if(ok) (*(int*)*contador)++;
+		}
+	}
+	print_test("Se contaron todas las claves", ok);
+	print_test("Se creo un contador por clave", llamadas == largo);
+	print_test("La cantidad de elementos es correcta", hash_cantidad(hash) == largo);
+	for(size_t i = 0; ok && i < largo; i++){
+		sprintf(clave, "%08zu", i);
+		int* contador = hash_obtener(hash, clave);
+		ok = contador != NULL && *contador == (int)repeticiones;
+	}
+	print_test("Cada contador llego a la cantidad de repeticiones", ok);
+	hash_destruir(hash);
+	printf("\n");
+}
+
+//Cuenta los elementos que recorre un iterador nuevo.
+size_t contar_iterando(const hash_t* hash){
+	size_t cantidad = 0;
+	hash_iter_t* iter = hash_iter_crear(hash);
+	if(!iter) return 0;
+	for(; !hash_iter_al_final(iter); hash_iter_avanzar(iter)) cantidad++;
+	hash_iter_destruir(iter);
+	return cantidad;
+}
+
+//Guarda y borra claves de a una, revisando despues de cada operacion que se encuentren
+//todas y que el iterador las recorra, asi se pasa por redimensiones a medio terminar.
+void pruebas_redimension_en_curso(size_t largo){
+	printf("### INICIO DE PRUEBAS DURANTE UNA REDIMENSION ###\n");
+	hash_t* hash = hash_crear(NULL);
+	char (*claves)[24] = malloc(largo * sizeof(*claves));
+	bool ok = hash && claves;
+	for(size_t i = 0; ok && i < largo; i++){
+		sprintf(claves[i], "%08zu", i);
+		ok = hash_guardar(hash, claves[i], claves[i]) && contar_iterando(hash) == i + 1;
+		for(size_t j = 0; ok && j <= i; j++) ok = hash_obtener(hash, claves[j]) == claves[j];
+	}
+	print_test("Al guardar se encuentran e iteran todas las claves", ok);
+	for(size_t i = 0; ok && i < largo; i++){
+		ok = hash_borrar(hash, claves[i]) == claves[i] && contar_iterando(hash) == largo - i - 1;
+		for(size_t j = i + 1; ok && j < largo; j++) ok = hash_pertenece(hash, claves[j]);
+		ok = ok && !hash_pertenece(hash, claves[i]);
+	}
+	print_test("Al borrar se encuentran e iteran las claves que quedan", ok);
+	print_test("El hash quedo vacio", ok && hash_cantidad(hash) == 0);
+	free(claves);
+	hash_destruir(hash);
+	printf("\n");
+}
+
+//Hace 'operaciones' busquedas, reemplazos y consultas de claves ausentes sobre un hash
+//con 'largo' claves, y despues borra las de un hash chico (que no se achica), contando
+//cuantas veces se pidio memoria mientras tanto.
+void pruebas_busquedas_sin_asignar(size_t largo, size_t operaciones){
+	printf("### INICIO DE PRUEBAS DE BUSQUEDAS SIN PEDIR MEMORIA ###\n");
+	const size_t largo_chico = 50;
+	size_t antes = asignaciones;
+	hash_t* hash = hash_crear(NULL);
+	hash_t* chico = hash_crear(NULL);
+	char (*claves)[24] = malloc(largo * sizeof(*claves));
+	int valor = 1;
+	bool ok = hash && chico && claves;
+	for(size_t i = 0; ok && i < largo; i++){
+		sprintf(claves[i], "%08zu", i);
+		ok = hash_guardar(hash, claves[i], &valor);
+		if(ok && i < largo_chico) ok = hash_guardar(chico, claves[i], &valor);
+	}
+	print_test("Se guardaron todas las claves", ok);
+	print_test("Crear hashes y guardar claves nuevas pidio memoria", asignaciones > antes);
+
+	antes = asignaciones;
+	for(size_t i = 0; ok && i < operaciones; i++){
+		const char* clave = claves[(i * 7919) % largo];
+		switch(i % 5){
+			case 0: ok = hash_obtener(hash, clave) == &valor; break;
+			case 1: ok = hash_pertenece(hash, clave); break;
+			case 2: ok = hash_guardar(hash, clave, &valor); break;
+			case 3: ok = hash_obtener_o_insertar(hash, clave, crear_nada, NULL) != NULL; break;
+			default: ok = hash_obtener(hash, "ausente") == NULL && hash_borrar(hash, "ausente") == NULL;
+		}
+	}
+	print_test("Las operaciones sobre claves existentes o ausentes funcionaron", ok);
+	print_test("Ninguna de esas operaciones pidio memoria", asignaciones == antes);
+
+	antes = asignaciones;
+	for(size_t i = 0; ok && i < largo_chico; i++){
+		ok = hash_borrar(chico, claves[i]) == &valor;
+	}
+	print_test("Se borraron todas las claves del hash chico", ok && hash_cantidad(chico) == 0);
+	print_test("Borrar no pidio memoria", asignaciones == antes);
+
+	free(claves);
+	hash_destruir(chico);
+	hash_destruir(hash);
+	printf("\n");
+}
+
+//Guarda 2^bits claves con el mismo djb2 (la funcion de hash anterior): "Ez" y "FY" dan lo
+//mismo, asi que cualquier combinacion de esos bloques tambien.
+void pruebas_funcion_hash(unsigned bits){
+	printf("### INICIO DE PRUEBAS DE LA FUNCION DE HASH ###\n");
+	semilla_hash_t semilla1 = {1, 2};
+	semilla_hash_t semilla2 = {3, 4};
+	print_test("La misma clave y semilla dan el mismo hash", funcion_hash("/index.html", &semilla1) == funcion_hash("/index.html", &semilla1));
+	print_test("Otra semilla da otro hash", funcion_hash("/index.html", &semilla1) != funcion_hash("/index.html", &semilla2));
+
+	size_t cantidad = (size_t)1 << bits;
+	hash_t* hash = hash_crear(NULL);
+	char clave[64];
+	bool ok = hash != NULL;
+	for(size_t i = 0; ok && i < cantidad; i++){
+		for(unsigned b = 0; b < bits; b++) memcpy(clave + 2 * b, (i >> b) & 1 ? "FY" : "Ez", 2);
+		clave[2 * bits] = '\0';
+		ok = hash_guardar(hash, clave, NULL);
+	}
+	print_test("Se guardaron las claves que colisionan en djb2", ok && hash_cantidad(hash) == cantidad);
+	for(size_t i = 0; ok && i < cantidad; i++){
+		for(unsigned b = 0; b < bits; b++) memcpy(clave + 2 * b, (i >> b) & 1 ? "FY" : "Ez", 2);
+		clave[2 * bits] = '\0';
+		ok = hash_pertenece(hash, clave);
+	}
+	print_test("Todas las claves pertenecen", ok);
+	hash_destruir(hash);
+	printf("\n");
+}
+
+void pruebas_hash_alumno(){
+	/*Ejecuta todas las funciones*/
+	pruebas_obtener_o_insertar_clave_nueva();
+	pruebas_obtener_o_insertar_clave_existente();
+	pruebas_obtener_o_insertar_sin_dato();
+	pruebas_obtener_o_insertar_copia_clave();
+	pruebas_obtener_o_insertar_contadores(5000);
+	pruebas_redimension_en_curso(1000);
+	pruebas_busquedas_sin_asignar(10000, 1000000);
+	pruebas_funcion_hash(14);
+}
@@ -3,93 +3,517 @@
 #include <time.h>
 #include <stdbool.h>
 #include <stdio.h>
-#include "lista.h"
 #include "hash.h"
 #include "DOS.h"
+#include "estadisticas.h"
+#include "salida.h"
 
-#define TIME_FORMAT "%FT%T%z"
+#include <string.h>
+#include <unistd.h>
 
+#define LARGO_FECHA_SIN_ZONA 19
+#define SEGUNDOS_POR_DIA 86400
+#define SEGUNDOS_POR_HORA 3600
+#define SEGUNDOS_POR_MINUTO 60
+//Ventana maxima de una regla, para que sus cuentas no desborden.
+#define MAX_SEGUNDOS_REGLA (366LL * SEGUNDOS_POR_DIA)
+
+#define TAM_CLAVE_IP (BITS_IP / 4 + 1)
+#define DIGITOS_CLAVE_IPV4 8
+
+//Regla por defecto: 5 solicitudes en menos de 2 segundos.
 #define N_SOL_CONSIDERADAS_DDOS 5
 #define RANGO_DE_TIEMPO_CONSIDERADO 2
 
+#define MAX_REGLAS_DOS 16
+//Las reglas de hasta esta cantidad de solicitudes se evaluan con los instantes exactos;
+//las demas, con contadores por cubetas de tiempo.
+#define MAX_SOLICITUDES_EXACTAS 32
+#define CUBETAS_POR_REGLA 16
+#define TAM_LINEA_REGLA 128
+
+//Al superar el limite de memoria, las solicitudes de ips nuevas se reparten en esta cantidad
+//de particiones en disco, segun la ip.
+#define CANT_PARTICIONES 32
+#define TAM_BUFFER_PARTICION (1 << 16)
+#define SOLICITUDES_POR_TANDA 1024
+//Memoria aproximada que ocupa cada ip en el hash ademas de su ventana: el item, la copia de
+//la clave, el nodo de la lista, su parte de la tabla y los encabezados de cada malloc.
+#define COSTO_ENTRADA_HASH 128
+#define DIRECTORIO_TEMPORAL "/tmp"
+#define PLANTILLA_TEMPORAL "tp2-dos-XXXXXX"
+
+typedef struct regla_dos {
+    size_t solicitudes;
+    time_t segundos;
+    time_t ancho_cubeta;    // Solo en las reglas por cubetas.
+    time_t cant_cubetas;    // Las necesarias para cubrir la regla aunque empiece en medio de una cubeta.
+} regla_dos_t;
+
+typedef struct reglas_dos {
+    regla_dos_t exactas[MAX_REGLAS_DOS];
+    size_t cant_exactas;
+    regla_dos_t por_cubetas[MAX_REGLAS_DOS];
+    size_t cant_por_cubetas;
+    size_t cant_instantes;  // La mayor cantidad de solicitudes de las reglas exactas.
+} reglas_dos_t;
+
+//Reglas con las que se evaluan todas las solicitudes. Solo cambian al cargar un archivo de reglas,
+//antes de procesar los logs, asi que los hilos las leen sin sincronizar.
+static reglas_dos_t reglas = {
+    .exactas = { { .solicitudes = N_SOL_CONSIDERADAS_DDOS, .segundos = RANGO_DE_TIEMPO_CONSIDERADO } },
+    .cant_exactas = 1,
+    .cant_por_cubetas = 0,
+    .cant_instantes = N_SOL_CONSIDERADAS_DDOS,
+};
+
+//Solicitudes de una regla por cubetas: cada cubeta cuenta las de ancho_cubeta segundos,
+//en un arreglo circular indexado por el numero de cubeta.
+typedef struct cubetas_regla {
+    time_t ultima;          // Numero de la cubeta mas nueva.
+    uint32_t total;         // Suma de las cubetas vigentes.
+    uint16_t cantidades[CUBETAS_POR_REGLA + 1];
+} cubetas_regla_t;
+
+//Estado de deteccion de una ip: las ultimas solicitudes, en un arreglo circular, para las
+//reglas exactas, y los contadores de cada regla por cubetas. Todas las reglas se actualizan
+//en la misma pasada, asi que el costo por solicitud no depende del largo de las reglas.
+typedef struct ventana_solicitudes {
+    uint32_t proxima;
+    uint32_t cantidad;
+    bool sospechosa;
+    cubetas_regla_t cubetas[];  // Uno por regla por cubetas, seguidos de reglas.cant_instantes time_t.
+} ventana_solicitudes_t;
+
+//Memoria para las ventanas de todos los logs que se procesan a la vez, o 0 si no hay limite.
+static size_t memoria_maxima = 0;
+
+//Solicitud guardada en una particion. Los archivos son temporales del proceso, asi que se
+//escribe la estructura tal cual.
+typedef struct solicitud_particionada {
+    ip_t ip;
+    time_t instante;
+} solicitud_particionada_t;
+
+struct detector_dos {
+    hash_t* peticiones_por_ip;
+    size_t max_ips;         // 0 si no hay limite.
+    unsigned nivel;         // Veces que ya se particionaron estas solicitudes; cambia el reparto.
+    bool error;             // Fallo la escritura de alguna particion.
+    FILE* particiones[CANT_PARTICIONES];   // Se crean al alcanzar max_ips.
+};
+
+void cache_fecha_inicializar(cache_fecha_t* cache) {
+
+    cache->valida = false;
+}
+
+//Lee 'cantidad' digitos decimales. Devuelve false si alguno no es un digito.
+static bool leer_digitos(const char* cadena, int cantidad, int* valor) {
+
+    int resultado = 0;
+    for (int i = 0; i < cantidad; i++) {
+        if (cadena[i] < '0' || cadena[i] > '9') return false;
+        resultado = resultado * 10 + (cadena[i] - '0');
+    }
+    *valor = resultado;
+    return true;
+}
+
+//Cantidad de dias desde 1970-01-01 hasta la fecha dada (calendario gregoriano).
+//Algoritmo "days_from_civil" de Howard Hinnant.
+static long dias_desde_epoca(int anio, int mes, int dia) {
+
+    anio -= mes <= 2;
+    long era = (anio >= 0 ? anio : anio - 399) / 400;
+    long anio_de_era = anio - era * 400;
+    long dia_del_anio = (153 * (mes + (mes > 2 ? -3 : 9)) + 2) / 5 + dia - 1;
+    long dia_de_era = anio_de_era * 365 + anio_de_era / 4 - anio_de_era / 100 + dia_del_anio;
+    return era * 146097 + dia_de_era - 719468;
+}
+
+//Cantidad de dias del mes (1 a 12) en ese anio del calendario gregoriano.
+static int dias_del_mes(int anio, int mes) {
+
+    static const int DIAS_POR_MES[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    bool bisiesto = (anio % 4 == 0 && anio % 100 != 0) || anio % 400 == 0;
+    return mes == 2 && bisiesto ? 29 : DIAS_POR_MES[mes - 1];
+}
+
+//Convierte la zona horaria (Z, +hh:mm o +hhmm) en segundos al este de UTC.
+static bool leer_zona(const char* zona, size_t largo, long* desplazamiento) {
+
+    if (largo == 1 && zona[0] == 'Z') {
+        *desplazamiento = 0;
+        return true;
+    }
+    if ((largo != 5 && largo != 6) || (zona[0] != '+' && zona[0] != '-')) return false;
+    int horas, minutos;
+    if (!leer_digitos(zona + 1, 2, &horas)) return false;
+    const char* inicio_minutos = largo == 6 ? zona + 4 : zona + 3;
+    if (largo == 6 && zona[3] != ':') return false;
+    if (!leer_digitos(inicio_minutos, 2, &minutos)) return false;
+    long segundos = horas * SEGUNDOS_POR_HORA + minutos * SEGUNDOS_POR_MINUTO;
+    *desplazamiento = zona[0] == '+' ? segundos : -segundos;
+    return true;
+}
+
+bool iso8601_a_tiempo(const char* iso8601, size_t largo, cache_fecha_t* cache, time_t* instante) {
+
+    if (largo <= LARGO_FECHA_SIN_ZONA) return false;
+    if (!cache->valida || memcmp(cache->dia, iso8601, LARGO_FECHA_DIA) != 0) {
+        int anio, mes, dia;
+        if (!leer_digitos(iso8601, 4, &anio) || iso8601[4] != '-' || !leer_digitos(iso8601 + 5, 2, &mes)
+            || iso8601[7] != '-' || !leer_digitos(iso8601 + 8, 2, &dia)) return false;
+        if (mes < 1 || mes > 12 || dia < 1 || dia > dias_del_mes(anio, mes)) return false;
+        memcpy(cache->dia, iso8601, LARGO_FECHA_DIA);
+        cache->inicio_dia = (time_t)(dias_desde_epoca(anio, mes, dia) * SEGUNDOS_POR_DIA);
+        cache->valida = true;
+    }
+    int horas, minutos, segundos;
+    if (iso8601[10] != 'T' || !leer_digitos(iso8601 + 11, 2, &horas) || iso8601[13] != ':'
+        || !leer_digitos(iso8601 + 14, 2, &minutos) || iso8601[16] != ':'
+        || !leer_digitos(iso8601 + 17, 2, &segundos)) return false;
+    // Como strptime, admite el segundo 60 de los segundos intercalares.
+    if (horas > 23 || minutos > 59 || segundos > 60) return false;
+    long desplazamiento;
+    if (!leer_zona(iso8601 + LARGO_FECHA_SIN_ZONA, largo - LARGO_FECHA_SIN_ZONA, &desplazamiento)) return false;
+
+    *instante = cache->inicio_dia + horas * SEGUNDOS_POR_HORA + minutos * SEGUNDOS_POR_MINUTO + segundos - desplazamiento;
+    return true;
+}
 
-// Dada una cadena en formato ISO-8601 devuelve una variable de tipo time_t
-// que representa un instante en el tiempo.
-time_t iso8601_to_time(const char* iso8601) {
-    struct tm bktime = { 0 };
-    strptime(iso8601, TIME_FORMAT, &bktime);
-    return mktime(&bktime);
+static time_t* instantes_de(ventana_solicitudes_t* ventana) {
+
+    return (time_t*)(ventana->cubetas + reglas.cant_por_cubetas);
 }
 
+static size_t tamanio_ventana(void) {
 
-//Recorre la lista de solicitudes y detecta si una direccion ip es sospechosa de DoS
-//Devuelve true o false dependiendo del estado de la operacion.
-bool usuario_hizo_mas_solicitudes_de_las_permitidas(lista_t* lista_solicitudes) {
+    return sizeof(ventana_solicitudes_t) + sizeof(cubetas_regla_t) * reglas.cant_por_cubetas
+        + sizeof(time_t) * reglas.cant_instantes;
+}
 
-    if (lista_largo(lista_solicitudes) < N_SOL_CONSIDERADAS_DDOS) return false;
-    lista_iter_t* iter_izq = lista_iter_crear(lista_solicitudes);
-    if (iter_izq == NULL) return false;
-    lista_iter_t* iter_der = lista_iter_crear(lista_solicitudes);
-    if (iter_der == NULL) return false;
+//Crea una ventana vacia, con lugar para lo que piden las reglas actuales.
+static ventana_solicitudes_t* crear_ventana(void) {
 
-    // Muevo el iter_der de tal forma que quede el iter_izq sobre la
-    // primera solicitud y iter_der sobre la quinta solicitud
-    for (int i = 0; i < N_SOL_CONSIDERADAS_DDOS - 1; i++) {
-        lista_iter_avanzar(iter_der);
+    ventana_solicitudes_t* ventana = malloc(tamanio_ventana());
+    if (ventana == NULL) return NULL;
+    ESTADISTICAS_SUMAR(CONTADOR_NODOS_CREADOS, 1);
+    ventana->proxima = 0;
+    ventana->cantidad = 0;
+    ventana->sospechosa = false;
+    for (size_t i = 0; i < reglas.cant_por_cubetas; i++) {
+        ventana->cubetas[i].ultima = 0;
+        ventana->cubetas[i].total = 0;
+        memset(ventana->cubetas[i].cantidades, 0, sizeof(ventana->cubetas[i].cantidades));
     }
-    bool estado = false;
-    while (!lista_iter_al_final(iter_der)) {
-        if (difftime(*((time_t *) lista_iter_ver_actual(iter_der)), *((time_t *) lista_iter_ver_actual(iter_izq))) < RANGO_DE_TIEMPO_CONSIDERADO) {
-            estado = true;
-            break;
+    return ventana;
+}
+
+//Numero de la cubeta del instante, redondeando hacia abajo tambien antes de 1970.
+static time_t numero_de_cubeta(const regla_dos_t* regla, time_t instante) {
+
+    time_t numero = instante / regla->ancho_cubeta;
+    return instante % regla->ancho_cubeta < 0 ? numero - 1 : numero;
+}
+
+//Posicion en el arreglo de cubetas de la cubeta con ese numero, aunque sea negativo.
+static size_t posicion_de_cubeta(const regla_dos_t* regla, time_t numero) {
+
+    time_t resto = numero % regla->cant_cubetas;
+    return (size_t)(resto < 0 ? resto + regla->cant_cubetas : resto);
+}
+
+//Suma la solicitud a su cubeta, vaciando antes las que quedaron fuera de la regla.
+//Devuelve true si las solicitudes de las cubetas vigentes alcanzan las de la regla. Puede
+//contar hasta ancho_cubeta segundos de mas, pero nunca deja afuera una solicitud del rango.
+static bool cubetas_agregar(cubetas_regla_t* cubetas, const regla_dos_t* regla, time_t instante) {
+
+    time_t numero = numero_de_cubeta(regla, instante);
+    if (cubetas->total == 0 || numero > cubetas->ultima) {
+        time_t a_vaciar = cubetas->total == 0 || numero - cubetas->ultima >= regla->cant_cubetas
+            ? regla->cant_cubetas : numero - cubetas->ultima;
+        for (time_t i = 1; i <= a_vaciar; i++) {
+            uint16_t* cubeta = &cubetas->cantidades[posicion_de_cubeta(regla, numero - a_vaciar + i)];
+            cubetas->total -= *cubeta;
+            *cubeta = 0;
         }
-        lista_iter_avanzar(iter_izq);
-        lista_iter_avanzar(iter_der);
+        cubetas->ultima = numero;
+    } else if (cubetas->ultima - numero >= regla->cant_cubetas) {
+        // Una solicitud desordenada que ya quedo fuera de todas las cubetas.
+        return false;
+    }
+    // Como las reglas piden a lo sumo UINT16_MAX solicitudes, una cubeta llena ya cumple la regla.
+    uint16_t* cubeta = &cubetas->cantidades[posicion_de_cubeta(regla, numero)];
+    if (*cubeta < UINT16_MAX) {
+        (*cubeta)++;
+        cubetas->total++;
     }
-    lista_iter_destruir(iter_izq);
-    lista_iter_destruir(iter_der);
-    return estado;
+    return cubetas->total >= regla->solicitudes;
 }
 
-//Agrega la fecha en que se hizo la solicitud a un recurso.
-//Devuelve true o false dependiendo del estado de la operacion.
-bool agregar_fecha_de_solicitud(char* ip, time_t* fecha, hash_t* peticiones_por_ip) {
+//Agrega el instante a la ventana y actualiza todas las reglas.
+//Devuelve true si la ip cumple alguna de las reglas con esta solicitud.
+static bool ventana_agregar(ventana_solicitudes_t* ventana, time_t instante) {
 
-    if (!hash_pertenece(peticiones_por_ip, ip)) {
-        lista_t *lista_aux = lista_crear();
-        hash_guardar(peticiones_por_ip, ip, lista_aux);
+    bool cumple = false;
+    for (size_t i = 0; i < reglas.cant_por_cubetas; i++) {
+        cumple = cubetas_agregar(&ventana->cubetas[i], &reglas.por_cubetas[i], instante) || cumple;
     }
-    lista_t* lista_asociada = (lista_t*)hash_obtener(peticiones_por_ip, ip);
-    return (lista_insertar_ultimo(lista_asociada, fecha));
+
+    time_t* instantes = instantes_de(ventana);
+    instantes[ventana->proxima] = instante;
+    ventana->proxima = (uint32_t)((ventana->proxima + 1) % reglas.cant_instantes);
+    if (ventana->cantidad < reglas.cant_instantes) ventana->cantidad++;
+    for (size_t i = 0; !cumple && i < reglas.cant_exactas; i++) {
+        // La solicitud numero 'solicitudes' contando desde la ultima hacia atras.
+        const regla_dos_t* regla = &reglas.exactas[i];
+        if (ventana->cantidad < regla->solicitudes) continue;
+        size_t posicion = (ventana->proxima + reglas.cant_instantes - regla->solicitudes) % reglas.cant_instantes;
+        cumple = difftime(instante, instantes[posicion]) < (double)regla->segundos;
+    }
+    return cumple;
 }
 
-//Imprimir posibles ip con DoS
-bool imprimir_dos(const char* direccion_ip, void* dato1, void* dato2){
+//Lee una regla "solicitudes segundos", donde los segundos pueden terminar en s, m o h.
+static bool leer_regla(const char* linea, regla_dos_t* regla) {
+
+    char* fin;
+    unsigned long long solicitudes = strtoull(linea, &fin, 10);
+    if (fin == linea || solicitudes == 0 || solicitudes > UINT16_MAX) return false;
+    const char* inicio_segundos = fin;
+    long long segundos = strtoll(inicio_segundos, &fin, 10);
+    if (fin == inicio_segundos || segundos <= 0) return false;
+    long long unidad = *fin == 'm' ? SEGUNDOS_POR_MINUTO : *fin == 'h' ? SEGUNDOS_POR_HORA : 1;
+    if (segundos > MAX_SEGUNDOS_REGLA / unidad) return false;
+    segundos *= unidad;
+    if (*fin == 's' || *fin == 'm' || *fin == 'h') fin++;
+    while (*fin == ' ' || *fin == '\t' || *fin == '\r' || *fin == '\n') fin++;
+    if (*fin != '\0') return false;
+    *regla = (regla_dos_t){ .solicitudes = (size_t)solicitudes, .segundos = (time_t)segundos };
+    return true;
+}
 
-    fprintf(stdout,"DoS: %s\n", direccion_ip);
+//Agrega la regla al grupo que le corresponde segun su cantidad de solicitudes.
+static bool agregar_regla(reglas_dos_t* nuevas, regla_dos_t regla) {
+
+    if (regla.solicitudes <= MAX_SOLICITUDES_EXACTAS) {
+        if (nuevas->cant_exactas == MAX_REGLAS_DOS) return false;
+        nuevas->exactas[nuevas->cant_exactas++] = regla;
+        if (regla.solicitudes > nuevas->cant_instantes) nuevas->cant_instantes = regla.solicitudes;
+        return true;
+    }
+    if (nuevas->cant_por_cubetas == MAX_REGLAS_DOS) return false;
+    regla.ancho_cubeta = (regla.segundos + CUBETAS_POR_REGLA - 1) / CUBETAS_POR_REGLA;
+    regla.cant_cubetas = (regla.segundos + regla.ancho_cubeta - 1) / regla.ancho_cubeta + 1;
+    nuevas->por_cubetas[nuevas->cant_por_cubetas++] = regla;
     return true;
 }
 
-//Funcion que modifica la firma de lista_destruir para ser utilizada en otra funcion.
-void wrapper_destruir_hash_solicitudes(void* lista) {
-    lista_t* lista_solicitudes = lista;
-    lista_destruir(lista_solicitudes, free);
+bool dos_cargar_reglas(const char* nombre_de_archivo) {
+
+    FILE* archivo = fopen(nombre_de_archivo, "r");
+    if (archivo == NULL) return false;
+    reglas_dos_t nuevas = { .cant_exactas = 0, .cant_por_cubetas = 0, .cant_instantes = 1 };
+    char linea[TAM_LINEA_REGLA];
+    bool ok = true;
+    while (ok && fgets(linea, TAM_LINEA_REGLA, archivo) != NULL) {
+        const char* actual = linea;
+        while (*actual == ' ' || *actual == '\t') actual++;
+        if (*actual == '#' || *actual == '\n' || *actual == '\r' || *actual == '\0') continue;
+        regla_dos_t regla;
+        ok = leer_regla(actual, &regla) && agregar_regla(&nuevas, regla);
+    }
+    ok = ok && !ferror(archivo) && nuevas.cant_exactas + nuevas.cant_por_cubetas > 0;
+    fclose(archivo);
+    if (ok) reglas = nuevas;
+    return ok;
+}
+
+//Escribe la ip en hexadecimal, para usarla como clave del hash. Las IPv4 usan solo sus
+//ultimos 8 digitos, asi que sus claves son cortas y no coinciden con las de las IPv6.
+static void ip_a_clave(ip_t ip, char* clave) {
+
+    const char* digitos = "0123456789abcdef";
+    size_t largo = ip_es_v4(ip) ? DIGITOS_CLAVE_IPV4 : TAM_CLAVE_IP - 1;
+    for (size_t i = largo; i > 0; i--) {
+        clave[i - 1] = digitos[(unsigned)ip & 0xF];
+        ip >>= 4;
+    }
+    clave[largo] = '\0';
+}
+
+//Adapta crear_ventana a hash_obtener_o_insertar.
+static void* crear_ventana_para_hash(const char* clave, void* extra) {
+
+    return crear_ventana();
+}
+
+bool registrar_solicitud(ip_t ip, time_t instante, hash_t* peticiones_por_ip, visitantes_t* DoS) {
+
+    char clave[TAM_CLAVE_IP];
+    ip_a_clave(ip, clave);
+    void** dato = hash_obtener_o_insertar(peticiones_por_ip, clave, crear_ventana_para_hash, NULL);
+    if (dato == NULL) return false;
+    ventana_solicitudes_t* ventana = *dato;
+    // Una ip ya detectada no se vuelve a informar, asi que no hace falta seguir contando.
+    if (ventana->sospechosa) return true;
+    if (ventana_agregar(ventana, instante)) {
+        ventana->sospechosa = true;
+        return visitantes_guardar(DoS, ip);
+    }
+    return true;
+}
+
+void dos_limitar_memoria(size_t bytes) {
+
+    memoria_maxima = bytes;
+}
+
+static detector_dos_t* crear_detector(size_t max_ips, unsigned nivel) {
+
+    detector_dos_t* detector = malloc(sizeof(detector_dos_t));
+    if (detector == NULL) return NULL;
+    detector->peticiones_por_ip = hash_crear(free);
+    if (detector->peticiones_por_ip == NULL) {
+        free(detector);
+        return NULL;
+    }
+    detector->max_ips = max_ips;
+    detector->nivel = nivel;
+    detector->error = false;
+    for (size_t i = 0; i < CANT_PARTICIONES; i++) detector->particiones[i] = NULL;
+    return detector;
+}
+
+detector_dos_t* detector_dos_crear(size_t simultaneos) {
+
+    size_t max_ips = 0;
+    if (memoria_maxima > 0 && simultaneos > 0) {
+        max_ips = memoria_maxima / simultaneos / (tamanio_ventana() + COSTO_ENTRADA_HASH);
+        if (max_ips == 0) max_ips = 1;
+    }
+    return crear_detector(max_ips, 0);
+}
+
+//Crea un archivo temporal en TMPDIR (o en /tmp) que se borra solo al cerrarlo.
+static FILE* crear_archivo_temporal(void) {
+
+    const char* directorio = getenv("TMPDIR");
+    if (directorio == NULL || *directorio == '\0') directorio = DIRECTORIO_TEMPORAL;
+    size_t largo = strlen(directorio) + sizeof(PLANTILLA_TEMPORAL) + 1;
+    char* nombre = malloc(largo);
+    if (nombre == NULL) return NULL;
+    snprintf(nombre, largo, "%s/%s", directorio, PLANTILLA_TEMPORAL);
+    int descriptor = mkstemp(nombre);
+    if (descriptor != -1) unlink(nombre);
+    free(nombre);
+    if (descriptor == -1) return NULL;
+    FILE* archivo = fdopen(descriptor, "w+b");
+    if (archivo == NULL) {
+        close(descriptor);
+        return NULL;
+    }
+    setvbuf(archivo, NULL, _IOFBF, TAM_BUFFER_PARTICION);
+    return archivo;
 }
 
-void identificar_posibles_DOS(hash_t* hash_a_analizar, abb_t* abb_temp_DOS) {
+//Elige la particion de la ip mezclando sus bits (como splitmix64) con el nivel, para que una
+//particion que se vuelve a particionar no mande todo a la misma.
+static size_t particion_de(ip_t ip, unsigned nivel) {
 
-    hash_iter_t* iter_hash = hash_iter_crear(hash_a_analizar);
-    if(iter_hash == NULL) return;
+    uint64_t mezcla = (uint64_t)(ip >> 64) ^ (uint64_t)ip;
+    mezcla += 0x9e3779b97f4a7c15ULL * (nivel + 1);
+    mezcla = (mezcla ^ (mezcla >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    mezcla = (mezcla ^ (mezcla >> 27)) * 0x94d049bb133111ebULL;
+    mezcla ^= mezcla >> 31;
+    return (size_t)(mezcla % CANT_PARTICIONES);
+}
+
+//Agrega la solicitud a su particion, creandolas la primera vez.
+static bool particionar(detector_dos_t* detector, ip_t ip, time_t instante) {
 
-    while (!hash_iter_al_final(iter_hash)) {
-        char* clave_actual = (char*)hash_iter_ver_actual(iter_hash);
-        lista_t* lista_solicitudes = hash_obtener(hash_a_analizar, clave_actual);
-        if (usuario_hizo_mas_solicitudes_de_las_permitidas(lista_solicitudes)) {
-            abb_guardar(abb_temp_DOS, clave_actual, NULL);
+    bool crear = detector->particiones[0] == NULL;
+    for (size_t i = 0; crear && i < CANT_PARTICIONES; i++) {
+        detector->particiones[i] = crear_archivo_temporal();
+        if (detector->particiones[i] == NULL) {
+            for (size_t j = 0; j < i; j++) {
+                fclose(detector->particiones[j]);
+                detector->particiones[j] = NULL;
+            }
+            return false;
         }
+    }
+    solicitud_particionada_t solicitud = { .ip = ip, .instante = instante };
+    return fwrite(&solicitud, sizeof(solicitud), 1, detector->particiones[particion_de(ip, detector->nivel)]) == 1;
+}
+
+bool detector_dos_registrar(detector_dos_t* detector, ip_t ip, time_t instante, visitantes_t* DoS) {
 
-        hash_iter_avanzar(iter_hash);
+    // Con el limite alcanzado, las ips que ya tienen ventana se siguen evaluando en memoria
+    // y las nuevas van a disco: cada ip queda entera en un solo lugar, con sus solicitudes en orden.
+    if (detector->max_ips > 0 && hash_cantidad(detector->peticiones_por_ip) >= detector->max_ips) {
+        char clave[TAM_CLAVE_IP];
+        ip_a_clave(ip, clave);
+        if (!hash_pertenece(detector->peticiones_por_ip, clave)) {
+            if (particionar(detector, ip, instante)) return true;
+            detector->error = true;
+            return false;
+        }
     }
-    hash_iter_destruir(iter_hash);
+    return registrar_solicitud(ip, instante, detector->peticiones_por_ip, DoS);
 }
 
+//Evalua las solicitudes de una particion con un detector propio, que a su vez particiona
+//si sus ips tampoco entran en memoria.
+static bool procesar_particion(FILE* particion, size_t max_ips, unsigned nivel, visitantes_t* DoS) {
+
+    if (fflush(particion) != 0 || fseek(particion, 0, SEEK_SET) != 0) return false;
+    detector_dos_t* detector = crear_detector(max_ips, nivel);
+    if (detector == NULL) return false;
+    solicitud_particionada_t tanda[SOLICITUDES_POR_TANDA];
+    size_t leidas;
+    while ((leidas = fread(tanda, sizeof(solicitud_particionada_t), SOLICITUDES_POR_TANDA, particion)) > 0) {
+        for (size_t i = 0; i < leidas; i++) {
+            detector_dos_registrar(detector, tanda[i].ip, tanda[i].instante, DoS);
+        }
+    }
+    bool ok = !ferror(particion) && detector_dos_finalizar(detector, DoS);
+    detector_dos_destruir(detector);
+    return ok;
+}
+
+bool detector_dos_finalizar(detector_dos_t* detector, visitantes_t* DoS) {
+
+    if (detector->error) return false;
+    if (detector->particiones[0] == NULL) return true;
+    // Las ips con ventana no estan en ninguna particion, asi que su memoria ya se puede liberar.
+    hash_destruir(detector->peticiones_por_ip);
+    detector->peticiones_por_ip = NULL;
+    bool ok = true;
+    for (size_t i = 0; ok && i < CANT_PARTICIONES; i++) {
+        ok = procesar_particion(detector->particiones[i], detector->max_ips, detector->nivel + 1, DoS);
+        fclose(detector->particiones[i]);
+        detector->particiones[i] = NULL;
+    }
+    return ok;
+}
+
+void detector_dos_destruir(detector_dos_t* detector) {
+
+    if (detector->peticiones_por_ip != NULL) hash_destruir(detector->peticiones_por_ip);
+    for (size_t i = 0; i < CANT_PARTICIONES; i++) {
+        if (detector->particiones[i] != NULL) fclose(detector->particiones[i]);
+    }
+    free(detector);
+}
+
+//Imprimir posibles ip con DoS
+bool imprimir_dos(ip_t ip, void* salida){
+
+    salida_cadena(salida, "DoS: ");
+    salida_ip(salida, ip);
+    salida_caracter(salida, '\n');
+    return true;
+}
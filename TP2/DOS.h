@@ -3,26 +3,73 @@
 
 #include "tp2.h"
 
-// Dada una cadena en formato ISO-8601 devuelve una variable de tipo time_t
-// que representa un instante en el tiempo.
-time_t iso8601_to_time(const char* iso8601);
+#define LARGO_FECHA_DIA 10
 
-//Recorre la lista de solicitudes y detecta si una direccion ip es sospechosa de DoS
-//Devuelve true o false dependiendo del estado de la operacion.
-bool usuario_hizo_mas_solicitudes_de_las_permitidas(lista_t* lista_solicitudes);
+//Ultimo dia (AAAA-MM-DD) convertido por iso8601_a_tiempo, con su instante de inicio.
+//Las lineas consecutivas de un log suelen compartir el dia, asi que se evita recalcularlo.
+typedef struct cache_fecha {
+    char dia[LARGO_FECHA_DIA];
+    time_t inicio_dia;
+    bool valida;
+} cache_fecha_t;
+
+//Inicializa una cache vacia.
+void cache_fecha_inicializar(cache_fecha_t* cache);
+
+//Convierte una fecha ISO-8601 con el formato fijo de los logs (AAAA-MM-DDThh:mm:ss
+//seguido de Z, +hh:mm o +hhmm) en un instante. Decodifica los digitos directamente y
+//calcula los segundos desde la epoca (UTC) sin consultar la zona horaria.
+//Post: devuelve false si los 'largo' caracteres no respetan el formato, el dia no
+//existe en ese mes o la hora no existe (admite el segundo 60).
+bool iso8601_a_tiempo(const char* iso8601, size_t largo, cache_fecha_t* cache, time_t* instante);
 
-//Agrega la fecha en que se hizo la solicitud a un recurso.
+//Reemplaza las reglas de deteccion de DoS por las del archivo. Cada linea no vacia que no
+//empieza con '#' es una regla "solicitudes segundos": una ip es sospechosa si hace esa
+//cantidad de solicitudes (hasta 65535) en menos de esa cantidad de segundos. Los segundos
+//pueden llevar el sufijo s, m o h (por ejemplo "1000 1h"). Por defecto la unica regla es "5 2".
+//Las reglas de hasta 32 solicitudes son exactas; las mayores cuentan por cubetas de un
+//dieciseisavo del rango, y pueden considerar hasta una cubeta de mas.
+//Debe llamarse antes de procesar cualquier log.
+//Devuelve false, sin cambiar las reglas, si el archivo no se puede leer, tiene una linea
+//invalida, no tiene reglas o tiene mas de 16 de alguno de los dos tipos.
+bool dos_cargar_reglas(const char* nombre_de_archivo);
+
+//Registra una solicitud de la ip y la evalua contra todas las reglas en una misma pasada.
+//Si con esta solicitud la ip cumple alguna, se guarda en el conjunto de posibles DoS en
+//ese mismo momento.
 //Devuelve true o false dependiendo del estado de la operacion.
-bool agregar_fecha_de_solicitud(char* ip, time_t* fecha, hash_t* peticiones_por_ip);
+bool registrar_solicitud(ip_t ip, time_t instante, hash_t* peticiones_por_ip, visitantes_t* DoS);
 
-//Imprimir posibles ip con DoS
-bool imprimir_dos(const char* direccion_ip, void* dato1, void* dato2);
+//Limita la memoria que usan las ventanas de DoS de todos los logs que se procesan a la vez.
+//Al alcanzar su parte del limite, un detector sigue evaluando en memoria las ips que ya vio
+//y guarda las solicitudes de las demas en particiones en disco, que evalua al finalizar.
+//Las particiones se crean en TMPDIR, o en /tmp. Con 0 (el valor por defecto) no hay limite.
+//Debe llamarse antes de procesar cualquier log.
+void dos_limitar_memoria(size_t bytes);
 
-//Funcion que modifica la firma de lista_destruir para ser utilizada en otra funcion.
-void wrapper_destruir_hash_solicitudes(void* lista);
+//Deteccion de DoS de un log: la ventana de cada ip y, si hizo falta, las particiones en disco.
+typedef struct detector_dos detector_dos_t;
 
-void identificar_posibles_DOS(hash_t* hash_a_analizar, abb_t* abb_temp_DOS);
+//Crea un detector que comparte el limite de memoria con otros 'simultaneos' - 1 que se usan
+//a la vez. Con 'simultaneos' en 0 no se limita la memoria, y todas las DoS se detectan al
+//registrar la solicitud que las produce. Devuelve NULL si no hay memoria.
+detector_dos_t* detector_dos_crear(size_t simultaneos);
 
-#endif //ALGOS_GITHUB_DOS_H
+//Como registrar_solicitud, pero si la ip es nueva y ya se alcanzo el limite de memoria,
+//la solicitud se guarda en disco y se evalua recien en detector_dos_finalizar.
+//Devuelve false si no se pudo guardar.
+bool detector_dos_registrar(detector_dos_t* detector, ip_t ip, time_t instante, visitantes_t* DoS);
 
+//Evalua las solicitudes que quedaron en disco, guardando sus DoS en el conjunto. Despues
+//de llamarla ya no se pueden registrar solicitudes.
+//Devuelve false si fallo la escritura o la lectura de alguna particion.
+bool detector_dos_finalizar(detector_dos_t* detector, visitantes_t* DoS);
+
+//Libera el detector y borra sus particiones.
+void detector_dos_destruir(detector_dos_t* detector);
+
+//Imprimir posibles ip con DoS en la salida_t* recibida.
+bool imprimir_dos(ip_t ip, void* salida);
+
+#endif //ALGOS_GITHUB_DOS_H
 
@@ -0,0 +1,117 @@
+#include <stdlib.h>
+#include <string.h>
+#include "arena_cadenas.h"
+#include "estadisticas.h"
+
+#define TAM_BLOQUE (64 * 1024)
+#define CAPACIDAD_INICIAL_IDS 1024
+
+/*******************************************************************
+ *                DEFINICION DE LOS TIPOS DE DATOS                 *
+ ******************************************************************/
+
+//Bloque de la arena. Las cadenas mas largas que TAM_BLOQUE van en un bloque propio.
+typedef struct bloque {
+    struct bloque* anterior;
+    size_t usado;
+    size_t capacidad;
+    char datos[];
+} bloque_t;
+
+struct arena_cadenas {
+    bloque_t* actual;       // Bloque donde se agregan las cadenas; los anteriores estan llenos.
+    const char** cadenas;   // Cadena de cada id.
+    size_t cantidad;
+    size_t capacidad;
+};
+
+/*******************************************************************
+*                        FUNCIONES PRIVADAS                        *
+*******************************************************************/
+
+//Crea un bloque con lugar para al menos 'minimo' bytes, encadenado al anterior.
+static bloque_t* crear_bloque(bloque_t* anterior, size_t minimo) {
+
+    size_t capacidad = minimo > TAM_BLOQUE ? minimo : TAM_BLOQUE;
+    bloque_t* bloque = malloc(sizeof(bloque_t) + capacidad);
+    if (bloque == NULL) return NULL;
+    ESTADISTICAS_SUMAR(CONTADOR_NODOS_CREADOS, 1);
+    bloque->anterior = anterior;
+    bloque->usado = 0;
+    bloque->capacidad = capacidad;
+    return bloque;
+}
+
+//Reserva 'tamanio' bytes contiguos en la arena.
+static char* reservar(arena_cadenas_t* arena, size_t tamanio) {
+
+    bloque_t* bloque = arena->actual;
+    if (bloque == NULL || bloque->capacidad - bloque->usado < tamanio) {
+        bloque = crear_bloque(arena->actual, tamanio);
+        if (bloque == NULL) return NULL;
+        arena->actual = bloque;
+    }
+    char* lugar = bloque->datos + bloque->usado;
+    bloque->usado += tamanio;
+    return lugar;
+}
+
+/*******************************************************************
+*                           PRIMITIVAS                             *
+*******************************************************************/
+
+arena_cadenas_t* arena_cadenas_crear(void) {
+
+    arena_cadenas_t* arena = malloc(sizeof(arena_cadenas_t));
+    if (arena == NULL) return NULL;
+    arena->cadenas = malloc(sizeof(const char*) * CAPACIDAD_INICIAL_IDS);
+    if (arena->cadenas == NULL) {
+        free(arena);
+        return NULL;
+    }
+    arena->actual = NULL;
+    arena->cantidad = 0;
+    arena->capacidad = CAPACIDAD_INICIAL_IDS;
+    return arena;
+}
+
+const char* arena_cadenas_guardar(arena_cadenas_t* arena, const char* cadena, uint32_t* id) {
+
+    if (arena->cantidad >= ARENA_SIN_ID) return NULL;
+    if (arena->cantidad == arena->capacidad) {
+        const char** cadenas = realloc(arena->cadenas, sizeof(const char*) * arena->capacidad * 2);
+        if (cadenas == NULL) return NULL;
+        arena->cadenas = cadenas;
+        arena->capacidad *= 2;
+    }
+    size_t tamanio = strlen(cadena) + 1;
+    char* copia = reservar(arena, tamanio);
+    if (copia == NULL) return NULL;
+    memcpy(copia, cadena, tamanio);
+    arena->cadenas[arena->cantidad] = copia;
+    *id = (uint32_t)arena->cantidad;
+    arena->cantidad++;
+    return copia;
+}
+
+const char* arena_cadenas_obtener(const arena_cadenas_t* arena, uint32_t id) {
+
+    return arena->cadenas[id];
+}
+
+size_t arena_cadenas_cantidad(const arena_cadenas_t* arena) {
+
+    return arena->cantidad;
+}
+
+void arena_cadenas_destruir(arena_cadenas_t* arena) {
+
+    if (arena == NULL) return;
+    while (arena->actual != NULL) {
+        bloque_t* anterior = arena->actual->anterior;
+        free(arena->actual);
+        arena->actual = anterior;
+    }
+    free(arena->cadenas);
+    free(arena);
+}
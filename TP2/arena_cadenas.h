@@ -0,0 +1,36 @@
+#ifndef ALGOS_GITHUB_ARENA_CADENAS_H
+#define ALGOS_GITHUB_ARENA_CADENAS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+//Arena de cadenas: guarda copias de cadenas una detras de otra en bloques grandes y
+//contiguos, y les asigna ids consecutivos desde 0. Las copias no se mueven ni se liberan
+//hasta destruir la arena, asi que se pueden compartir como claves sin volver a copiarlas.
+typedef struct arena_cadenas arena_cadenas_t;
+
+#define ARENA_SIN_ID UINT32_MAX
+
+/*******************************************************************
+*                           PRIMITIVAS                             *
+*******************************************************************/
+
+//Crea una arena vacia.
+//Post: devuelve NULL si fallo la memoria.
+arena_cadenas_t* arena_cadenas_crear(void);
+
+//Copia la cadena al final de la arena y guarda su id en 'id'.
+//Post: devuelve la copia, NULL si fallo la memoria o ya no quedan ids.
+const char* arena_cadenas_guardar(arena_cadenas_t* arena, const char* cadena, uint32_t* id);
+
+//Devuelve la cadena con ese id.
+//Pre: id < arena_cadenas_cantidad(arena).
+const char* arena_cadenas_obtener(const arena_cadenas_t* arena, uint32_t id);
+
+//Devuelve la cantidad de cadenas guardadas.
+size_t arena_cadenas_cantidad(const arena_cadenas_t* arena);
+
+//Destruye la arena junto con todas sus cadenas.
+void arena_cadenas_destruir(arena_cadenas_t* arena);
+
+#endif //ALGOS_GITHUB_ARENA_CADENAS_H
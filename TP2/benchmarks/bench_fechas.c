@@ -0,0 +1,128 @@
+#define _XOPEN_SOURCE 700
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "tp2.h"
+
+#define REPETICIONES 200
+#define TIME_FORMAT "%FT%T%z"
+#define NANOSEGUNDOS_POR_SEGUNDO 1e9
+
+/*
+ * Microbenchmark de iso8601_to_time (strptime + mktime) contra iso8601_a_tiempo.
+ * Uso: ./bench_fechas access001.log [access002.log ...]
+ * Toma el campo de fecha de cada linea y convierte todas las fechas REPETICIONES veces.
+ */
+
+// Conversion con strptime + mktime, que se usaba antes de iso8601_a_tiempo y queda como
+// referencia para comparar.
+static time_t iso8601_to_time(const char* iso8601) {
+    struct tm bktime = { 0 };
+    strptime(iso8601, TIME_FORMAT, &bktime);
+    return mktime(&bktime);
+}
+
+typedef struct fechas {
+    char** cadenas;
+    size_t cantidad;
+    size_t capacidad;
+} fechas_t;
+
+static bool agregar_fecha(fechas_t* fechas, const char* inicio, size_t largo) {
+
+    if (fechas->cantidad == fechas->capacidad) {
+        size_t capacidad = fechas->capacidad > 0 ? fechas->capacidad * 2 : 1024;
+        char** cadenas = realloc(fechas->cadenas, sizeof(char*) * capacidad);
+        if (cadenas == NULL) return false;
+        fechas->cadenas = cadenas;
+        fechas->capacidad = capacidad;
+    }
+    char* cadena = malloc(largo + 1);
+    if (cadena == NULL) return false;
+    memcpy(cadena, inicio, largo);
+    cadena[largo] = '\0';
+    fechas->cadenas[fechas->cantidad++] = cadena;
+    return true;
+}
+
+static bool cargar_fechas(const char* nombre_archivo, fechas_t* fechas) {
+
+    FILE* archivo = fopen(nombre_archivo, "r");
+    if (archivo == NULL) return false;
+    char* linea = NULL;
+    size_t capacidad = 0;
+    ssize_t leidos;
+    while ((leidos = getline(&linea, &capacidad, archivo)) > 0) {
+        registro_t registro;
+        size_t largo = (size_t)leidos;
+        if (linea[largo - 1] == '\n') largo--;
+        if (!parsear_registro(linea, largo, &registro)) continue;
+        if (!agregar_fecha(fechas, registro.fecha.inicio, registro.fecha.largo)) break;
+    }
+    free(linea);
+    fclose(archivo);
+    return true;
+}
+
+static double segundos_desde(const struct timespec* inicio) {
+
+    struct timespec fin;
+    clock_gettime(CLOCK_MONOTONIC, &fin);
+    return (double)(fin.tv_sec - inicio->tv_sec) + (double)(fin.tv_nsec - inicio->tv_nsec) / NANOSEGUNDOS_POR_SEGUNDO;
+}
+
+int main(int argc, char* argv[]) {
+
+    if (argc < 2) {
+        fprintf(stderr, "Uso: %s <log> [<log> ...]\n", argv[0]);
+        return 1;
+    }
+    // mktime usa la zona local; con UTC ambos resultados son comparables.
+    setenv("TZ", "UTC", 1);
+    tzset();
+
+    fechas_t fechas = { 0 };
+    for (int i = 1; i < argc; i++) {
+        if (!cargar_fechas(argv[i], &fechas)) fprintf(stderr, "No se pudo leer %s\n", argv[i]);
+    }
+    if (fechas.cantidad == 0) return 1;
+
+    size_t distintas = 0;
+    cache_fecha_t cache;
+    cache_fecha_inicializar(&cache);
+    for (size_t i = 0; i < fechas.cantidad; i++) {
+        time_t rapida;
+        bool valida = iso8601_a_tiempo(fechas.cadenas[i], strlen(fechas.cadenas[i]), &cache, &rapida);
+        if (valida && rapida != iso8601_to_time(fechas.cadenas[i])) distintas++;
+    }
+
+    time_t acumulado = 0;
+    struct timespec inicio;
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+    for (int r = 0; r < REPETICIONES; r++) {
+        for (size_t i = 0; i < fechas.cantidad; i++) acumulado += iso8601_to_time(fechas.cadenas[i]);
+    }
+    double segundos_strptime = segundos_desde(&inicio);
+
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+    for (int r = 0; r < REPETICIONES; r++) {
+        for (size_t i = 0; i < fechas.cantidad; i++) {
+            time_t instante = 0;
+            iso8601_a_tiempo(fechas.cadenas[i], strlen(fechas.cadenas[i]), &cache, &instante);
+            acumulado -= instante;
+        }
+    }
+    double segundos_rapida = segundos_desde(&inicio);
+
+    double conversiones = (double)fechas.cantidad * REPETICIONES;
+    printf("fechas: %zu (x%d repeticiones), resultados distintos: %zu\n", fechas.cantidad, REPETICIONES, distintas);
+    printf("iso8601_to_time:  %8.1f ns/fecha\n", segundos_strptime * NANOSEGUNDOS_POR_SEGUNDO / conversiones);
+    printf("iso8601_a_tiempo: %8.1f ns/fecha\n", segundos_rapida * NANOSEGUNDOS_POR_SEGUNDO / conversiones);
+    printf("aceleracion: %.1fx (control %ld)\n", segundos_strptime / segundos_rapida, (long)acumulado);
+
+    for (size_t i = 0; i < fechas.cantidad; i++) free(fechas.cadenas[i]);
+    free(fechas.cadenas);
+    return 0;
+}
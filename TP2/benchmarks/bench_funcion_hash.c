@@ -0,0 +1,194 @@
+#define _XOPEN_SOURCE 700
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "funcion_hash.h"
+#include "hash.h"
+
+#define NANOSEGUNDOS_POR_SEGUNDO 1e9
+#define BYTES_POR_MEGABYTE (1024.0 * 1024.0)
+#define OPERACIONES_POR_MILLON 1e6
+#define BYTES_A_HASHEAR (256u * 1024u * 1024u)  // Por cada largo y cada funcion.
+#define CLAVES_POR_LARGO 4096
+#define MAX_BITS 24
+#define SEMILLA 88172645463325252ULL
+
+/*
+ * Benchmark de funcion_hash (SipHash-1-3 con semilla) contra djb2, la funcion anterior.
+ * Uso: ./bench_funcion_hash <bits>
+ * 1) Velocidad: hashea claves de distintos largos con las dos funciones.
+ * 2) Claves adversarias: arma 2^bits rutas con el mismo djb2 ("Ez" y "FY" dan lo mismo,
+ *    asi que cualquier combinacion de esos bloques tambien) y cuenta, con un balde por
+ *    clave, el largo de la cadena mas larga que quedaria con cada funcion. Despues las
+ *    guarda en un hash_t, y para comparar guarda la misma cantidad de rutas comunes.
+ */
+
+static const char* const BLOQUES_COLISION[] = {"Ez", "FY"};
+static const size_t LARGOS[] = {8, 16, 32, 64, 128, 256};
+
+static double segundos_desde(const struct timespec* inicio) {
+
+    struct timespec fin;
+    clock_gettime(CLOCK_MONOTONIC, &fin);
+    return (double)(fin.tv_sec - inicio->tv_sec) + (double)(fin.tv_nsec - inicio->tv_nsec) / NANOSEGUNDOS_POR_SEGUNDO;
+}
+
+//La funcion de hash que se usaba antes, para comparar.
+static size_t djb2(const char* str, const semilla_hash_t* semilla) {
+
+    size_t hash = 5381;
+    int c;
+    while ((c = *str++)) {
+        hash = ((hash << 5) + hash) + (size_t)c;
+    }
+    return hash;
+}
+
+typedef size_t (*funcion_t)(const char*, const semilla_hash_t*);
+
+//Generador xorshift64, para que las claves no dependan de la libc.
+static uint64_t aleatorio(uint64_t* estado) {
+
+    *estado ^= *estado << 13;
+    *estado ^= *estado >> 7;
+    *estado ^= *estado << 17;
+    return *estado;
+}
+
+//Arma CLAVES_POR_LARGO rutas de 'largo' bytes, una detras de otra cada 'largo' + 1 bytes.
+static char* generar_rutas(size_t largo) {
+
+    char* claves = malloc(CLAVES_POR_LARGO * (largo + 1));
+    if (claves == NULL) return NULL;
+    uint64_t estado = SEMILLA;
+    for (size_t i = 0; i < CLAVES_POR_LARGO; i++) {
+        char* clave = claves + i * (largo + 1);
+        clave[0] = '/';
+        for (size_t j = 1; j < largo; j++) clave[j] = (char)('a' + aleatorio(&estado) % 26);
+        clave[largo] = '\0';
+    }
+    return claves;
+}
+
+//Hashea todas las claves hasta pasar BYTES_A_HASHEAR y devuelve millones de hashes por segundo.
+static double medir_velocidad(funcion_t funcion, const char* claves, size_t largo, size_t* acumulado) {
+
+    semilla_hash_t semilla;
+    semilla_hash_aleatoria(&semilla);
+    size_t vueltas = BYTES_A_HASHEAR / (CLAVES_POR_LARGO * largo);
+    struct timespec inicio;
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+    for (size_t v = 0; v < vueltas; v++) {
+        for (size_t i = 0; i < CLAVES_POR_LARGO; i++) *acumulado += funcion(claves + i * (largo + 1), &semilla);
+    }
+    return (double)(vueltas * CLAVES_POR_LARGO) / segundos_desde(&inicio) / OPERACIONES_POR_MILLON;
+}
+
+static int medir_velocidades(void) {
+
+    size_t acumulado = 0;
+    printf("%8s %14s %14s %14s %14s\n", "largo", "djb2(M/s)", "djb2(MB/s)", "siphash(M/s)", "siphash(MB/s)");
+    for (size_t l = 0; l < sizeof(LARGOS) / sizeof(LARGOS[0]); l++) {
+        char* claves = generar_rutas(LARGOS[l]);
+        if (claves == NULL) return 1;
+        double djb2_por_segundo = medir_velocidad(djb2, claves, LARGOS[l], &acumulado);
+        double sip_por_segundo = medir_velocidad(funcion_hash, claves, LARGOS[l], &acumulado);
+        printf("%8zu %14.1f %14.1f %14.1f %14.1f\n", LARGOS[l],
+               djb2_por_segundo, djb2_por_segundo * OPERACIONES_POR_MILLON * (double)LARGOS[l] / BYTES_POR_MEGABYTE,
+               sip_por_segundo, sip_por_segundo * OPERACIONES_POR_MILLON * (double)LARGOS[l] / BYTES_POR_MEGABYTE);
+        free(claves);
+    }
+    // Se imprime para que el compilador no descarte los hashes.
+    printf("(control %zx)\n\n", acumulado);
+    return 0;
+}
+
+//Arma 2^bits rutas "/x/<bloques>.html" con el mismo djb2. Si 'comunes' es true, en lugar
+//de bloques que colisionan usa el numero de la clave en hexadecimal, con el mismo largo.
+static char* generar_adversarias(unsigned bits, bool comunes, size_t* largo) {
+
+    size_t cantidad = (size_t)1 << bits;
+    *largo = strlen("/x/") + 2 * bits + strlen(".html");
+    char* claves = malloc(cantidad * (*largo + 1));
+    if (claves == NULL) return NULL;
+    for (size_t i = 0; i < cantidad; i++) {
+        char* clave = claves + i * (*largo + 1);
+        char* actual = clave + sprintf(clave, "/x/");
+        if (comunes) {
+            actual += sprintf(actual, "%0*zx", (int)(2 * bits), i);
+        } else {
+            for (unsigned b = 0; b < bits; b++) actual += sprintf(actual, "%s", BLOQUES_COLISION[(i >> b) & 1]);
+        }
+        sprintf(actual, ".html");
+    }
+    return claves;
+}
+
+//Cuenta cuantas claves caen en cada balde de una tabla con un balde por clave y devuelve
+//el mayor.
+static size_t cadena_mas_larga(funcion_t funcion, const char* claves, size_t largo, size_t cantidad) {
+
+    semilla_hash_t semilla;
+    semilla_hash_aleatoria(&semilla);
+    size_t* baldes = calloc(cantidad, sizeof(size_t));
+    if (baldes == NULL) return 0;
+    size_t maximo = 0;
+    for (size_t i = 0; i < cantidad; i++) {
+        size_t* balde = &baldes[funcion(claves + i * (largo + 1), &semilla) % cantidad];
+        if (++*balde > maximo) maximo = *balde;
+    }
+    free(baldes);
+    return maximo;
+}
+
+//Guarda todas las claves en un hash_t y devuelve millones de claves por segundo.
+static double medir_guardado(const char* claves, size_t largo, size_t cantidad) {
+
+    hash_t* hash = hash_crear(NULL);
+    if (hash == NULL) return 0;
+    struct timespec inicio;
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+    bool ok = true;
+    for (size_t i = 0; ok && i < cantidad; i++) ok = hash_guardar(hash, claves + i * (largo + 1), NULL);
+    double segundos = segundos_desde(&inicio);
+    ok = ok && hash_cantidad(hash) == cantidad;
+    hash_destruir(hash);
+    return ok ? (double)cantidad / segundos / OPERACIONES_POR_MILLON : 0;
+}
+
+static int medir_adversarias(unsigned bits) {
+
+    size_t cantidad = (size_t)1 << bits;
+    size_t largo;
+    char* adversarias = generar_adversarias(bits, false, &largo);
+    char* comunes = generar_adversarias(bits, true, &largo);
+    if (adversarias == NULL || comunes == NULL) {
+        free(adversarias);
+        free(comunes);
+        return 1;
+    }
+    printf("%zu claves de %zu bytes, un balde por clave\n", cantidad, largo);
+    printf("%-12s %16s %16s %16s\n", "claves", "cadena djb2", "cadena siphash", "hash_guardar(M/s)");
+    printf("%-12s %16zu %16zu %16.2f\n", "adversarias", cadena_mas_larga(djb2, adversarias, largo, cantidad),
+           cadena_mas_larga(funcion_hash, adversarias, largo, cantidad), medir_guardado(adversarias, largo, cantidad));
+    printf("%-12s %16zu %16zu %16.2f\n", "comunes", cadena_mas_larga(djb2, comunes, largo, cantidad),
+           cadena_mas_larga(funcion_hash, comunes, largo, cantidad), medir_guardado(comunes, largo, cantidad));
+    free(adversarias);
+    free(comunes);
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+
+    char* fin = NULL;
+    unsigned long bits = argc == 2 ? strtoul(argv[1], &fin, 10) : 0;
+    if (argc != 2 || fin == argv[1] || *fin != '\0' || bits == 0 || bits > MAX_BITS) {
+        fprintf(stderr, "Uso: %s <bits> (entre 1 y %d)\n", argv[0], MAX_BITS);
+        return 1;
+    }
+    if (medir_velocidades() != 0) return 1;
+    return medir_adversarias((unsigned)bits);
+}
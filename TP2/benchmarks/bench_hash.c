@@ -0,0 +1,202 @@
+#define _XOPEN_SOURCE 700
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+#include "hash.h"
+
+#define NANOSEGUNDOS_POR_SEGUNDO 1e9
+#define OPERACIONES_POR_MILLON 1e6
+#define TAM_MAXIMO_CLAVE 32
+#define FORMATO_CLAVE "/articulos/%zu.html"
+#define SEMILLA 88172645463325252ULL
+#define NANOSEGUNDOS_POR_MICROSEGUNDO 1e3
+#define ANCHO_BALDE_LATENCIA 32     // En nanosegundos.
+#define BALDES_LATENCIA 65536       // Las latencias mayores van al ultimo balde.
+#define PERCENTIL_LATENCIA 0.999
+
+#ifdef HASH_ROBIN_HOOD
+#define IMPLEMENTACION "robin_hood"
+#else
+#define IMPLEMENTACION "encadenado"
+#endif
+
+/*
+ * Benchmark de la tabla de hash.
+ * Uso: ./bench_hash <claves> [<claves> ...]
+ * Para cada cantidad, en un proceso aparte, guarda esa cantidad de claves con forma de
+ * recurso (hash_guardar), las busca a todas en otro orden (hash_obtener con acierto) y
+ * busca la misma cantidad de claves ausentes. Informa millones de operaciones por segundo,
+ * el percentil 99.9 y el maximo de la latencia de cada hash_guardar (ahi pegan las
+ * redimensiones) y el pico de memoria. Cada guardado se cronometra por separado, lo que
+ * suma unos pocos nanosegundos a cada uno. Se compila una vez por implementacion (make bench_hash), asi que
+ * las dos se comparan con las mismas claves.
+ */
+
+static double segundos_desde(const struct timespec* inicio) {
+
+    struct timespec fin;
+    clock_gettime(CLOCK_MONOTONIC, &fin);
+    return (double)(fin.tv_sec - inicio->tv_sec) + (double)(fin.tv_nsec - inicio->tv_nsec) / NANOSEGUNDOS_POR_SEGUNDO;
+}
+
+static uint64_t nanosegundos(const struct timespec* momento) {
+
+    return (uint64_t)momento->tv_sec * (uint64_t)NANOSEGUNDOS_POR_SEGUNDO + (uint64_t)momento->tv_nsec;
+}
+
+//Devuelve la latencia, en nanosegundos, por debajo de la cual queda la fraccion pedida
+//de las mediciones del histograma. Si cae en el ultimo balde devuelve la maxima.
+static uint64_t percentil(const size_t* histograma, size_t total, double fraccion, uint64_t maxima) {
+
+    size_t objetivo = (size_t)((double)total * fraccion);
+    size_t acumuladas = 0;
+    for (size_t i = 0; i < BALDES_LATENCIA - 1; i++) {
+        acumuladas += histograma[i];
+        if (acumuladas > objetivo) return (i + 1) * ANCHO_BALDE_LATENCIA;
+    }
+    return maxima;
+}
+
+//Generador xorshift64, para que el orden de las busquedas no dependa de la libc.
+static uint64_t aleatorio(uint64_t* estado) {
+
+    *estado ^= *estado << 13;
+    *estado ^= *estado >> 7;
+    *estado ^= *estado << 17;
+    return *estado;
+}
+
+//Escribe las claves una detras de otra en 'datos' y devuelve donde empieza cada una.
+static char** generar_claves(size_t cantidad, char** datos) {
+
+    *datos = malloc(cantidad * TAM_MAXIMO_CLAVE);
+    char** claves = malloc(cantidad * sizeof(char*));
+    if (*datos == NULL || claves == NULL) {
+        free(*datos);
+        free(claves);
+        return NULL;
+    }
+    char* actual = *datos;
+    for (size_t i = 0; i < cantidad; i++) {
+        claves[i] = actual;
+        actual += snprintf(actual, TAM_MAXIMO_CLAVE, FORMATO_CLAVE, i) + 1;
+    }
+    return claves;
+}
+
+static void mezclar(char** claves, size_t cantidad) {
+
+    uint64_t estado = SEMILLA;
+    for (size_t i = cantidad; i > 1; i--) {
+        size_t j = (size_t)(aleatorio(&estado) % i);
+        char* auxiliar = claves[i - 1];
+        claves[i - 1] = claves[j];
+        claves[j] = auxiliar;
+    }
+}
+
+//Busca todas las claves y devuelve cuantas estaban.
+static size_t buscar_todas(const hash_t* hash, char** claves, size_t cantidad) {
+
+    size_t encontradas = 0;
+    for (size_t i = 0; i < cantidad; i++) {
+        if (hash_obtener(hash, claves[i]) != NULL) encontradas++;
+    }
+    return encontradas;
+}
+
+//Mide una cantidad de claves y escribe una fila de resultados. Corre en el proceso hijo.
+static int medir(size_t cantidad) {
+
+    char* datos;
+    char** claves = generar_claves(cantidad, &datos);
+    hash_t* hash = hash_crear(NULL);
+    size_t* histograma = calloc(BALDES_LATENCIA, sizeof(size_t));
+    if (claves == NULL || hash == NULL || histograma == NULL) {
+        fprintf(stderr, "No hay memoria para %zu claves\n", cantidad);
+        return 1;
+    }
+
+    struct timespec inicio;
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+    bool ok = true;
+    struct timespec antes = inicio, despues;
+    uint64_t maxima = 0;
+    for (size_t i = 0; ok && i < cantidad; i++) {
+        ok = hash_guardar(hash, claves[i], claves[i]);
+        clock_gettime(CLOCK_MONOTONIC, &despues);
+        uint64_t latencia = nanosegundos(&despues) - nanosegundos(&antes);
+        size_t balde = (size_t)(latencia / ANCHO_BALDE_LATENCIA);
+        histograma[balde < BALDES_LATENCIA ? balde : BALDES_LATENCIA - 1]++;
+        if (latencia > maxima) maxima = latencia;
+        antes = despues;
+    }
+    double segundos_guardar = segundos_desde(&inicio);
+    uint64_t latencia_percentil = percentil(histograma, cantidad, PERCENTIL_LATENCIA, maxima);
+
+    mezclar(claves, cantidad);
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+    ok = buscar_todas(hash, claves, cantidad) == cantidad && ok;
+    double segundos_aciertos = segundos_desde(&inicio);
+
+    // El hash tiene sus propias copias, asi que cambiar las originales da claves ausentes.
+    for (size_t i = 0; i < cantidad; i++) claves[i][1] = 'A';
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+    ok = buscar_todas(hash, claves, cantidad) == 0 && ok;
+    double segundos_fallos = segundos_desde(&inicio);
+
+    struct rusage uso;
+    getrusage(RUSAGE_SELF, &uso);
+    printf("%-12s %12zu %12.2f %12.2f %12.2f %12.2f %12.1f %10.1f\n", IMPLEMENTACION, cantidad,
+           (double)cantidad / segundos_guardar / OPERACIONES_POR_MILLON,
+           (double)cantidad / segundos_aciertos / OPERACIONES_POR_MILLON,
+           (double)cantidad / segundos_fallos / OPERACIONES_POR_MILLON,
+           (double)latencia_percentil / NANOSEGUNDOS_POR_MICROSEGUNDO, (double)maxima / NANOSEGUNDOS_POR_MICROSEGUNDO,
+           (double)uso.ru_maxrss / 1024.0);
+
+    hash_destruir(hash);
+    free(histograma);
+    free(claves);
+    free(datos);
+    return ok ? 0 : 1;
+}
+
+int main(int argc, char* argv[]) {
+
+    if (argc < 2) {
+        fprintf(stderr, "Uso: %s <claves> [<claves> ...]\n", argv[0]);
+        return 1;
+    }
+    printf("%-12s %12s %12s %12s %12s %12s %12s %10s\n", "hash", "claves", "guardar(M/s)", "aciertos(M/s)", "fallos(M/s)",
+           "p99.9(us)", "max(us)", "RSS(MB)");
+    fflush(stdout);
+    int resultado = 0;
+    for (int i = 1; i < argc; i++) {
+        char* fin;
+        unsigned long long cantidad = strtoull(argv[i], &fin, 10);
+        if (fin == argv[i] || *fin != '\0' || cantidad == 0) {
+            fprintf(stderr, "Cantidad invalida: %s\n", argv[i]);
+            return 1;
+        }
+        // Cada medicion en su proceso, para que el pico de memoria sea solo de esa cantidad.
+        pid_t hijo = fork();
+        if (hijo == -1) return 1;
+        if (hijo == 0) {
+            int estado = medir((size_t)cantidad);
+            fflush(stdout);
+            _exit(estado);
+        }
+        int estado;
+        if (waitpid(hijo, &estado, 0) == -1 || !WIFEXITED(estado) || WEXITSTATUS(estado) != 0) {
+            fprintf(stderr, "Fallo la medicion de %llu claves\n", cantidad);
+            resultado = 1;
+        }
+    }
+    return resultado;
+}
@@ -0,0 +1,134 @@
+#define _XOPEN_SOURCE 700
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <time.h>
+#include "tp2.h"
+#include "hyperloglog.h"
+
+#define NANOSEGUNDOS_POR_SEGUNDO 1e9
+#define CAPACIDAD_TOP 1000
+#define K_MAS_VISITADOS 10
+#define TAM_BLOQUE_LECTURA (1 << 20)
+
+//Cotas del modo aproximado, las mismas que usa el programa por defecto.
+#define ERROR_CONTEO 0.0001
+#define PROBABILIDAD_FALLA 0.01
+#define ERROR_VISITANTES 0.01
+
+/*
+ * Benchmark de punta a punta de TP2.
+ * Uso: ./bench_tp2 [-a] <log> [<log> ...]
+ * Cada log se mide en un proceso aparte, con estructuras nuevas, para que el pico de
+ * memoria (maxrss) de uno no se mezcle con el de otro. Se mide la carga del archivo
+ * (agregar_archivo), ver_visitantes sobre todo el rango de ips y ver_mas_visitados 10;
+ * lo que imprimen los comandos se descarta. Con -a se usa el modo aproximado.
+ */
+
+static double segundos_desde(const struct timespec* inicio) {
+
+    struct timespec fin;
+    clock_gettime(CLOCK_MONOTONIC, &fin);
+    return (double)(fin.tv_sec - inicio->tv_sec) + (double)(fin.tv_nsec - inicio->tv_nsec) / NANOSEGUNDOS_POR_SEGUNDO;
+}
+
+//Cuenta las lineas del archivo. Devuelve -1 si no se pudo leer.
+static long long contar_lineas(const char* nombre_archivo) {
+
+    FILE* archivo = fopen(nombre_archivo, "r");
+    if (archivo == NULL) return -1;
+    char* bloque = malloc(TAM_BLOQUE_LECTURA);
+    if (bloque == NULL) {
+        fclose(archivo);
+        return -1;
+    }
+    long long lineas = 0;
+    size_t leidos;
+    while ((leidos = fread(bloque, 1, TAM_BLOQUE_LECTURA, archivo)) > 0) {
+        for (const char* p = bloque; (p = memchr(p, '\n', (size_t)(bloque + leidos - p))) != NULL; p++) lineas++;
+    }
+    free(bloque);
+    fclose(archivo);
+    return lineas;
+}
+
+//Mide un archivo y escribe una fila de resultados en 'resultados'. Corre en el proceso hijo.
+static int medir_archivo(char* nombre_archivo, bool aproximado, FILE* resultados) {
+
+    long long lineas = contar_lineas(nombre_archivo);
+    visitantes_t* visitantes = aproximado ? visitantes_crear_aproximado(hll_precision_para_error(ERROR_VISITANTES))
+                                          : visitantes_crear();
+    recursos_t* recursos = aproximado ? recursos_crear_aproximado(CAPACIDAD_TOP, ERROR_CONTEO, PROBABILIDAD_FALLA)
+                                      : recursos_crear(CAPACIDAD_TOP);
+    if (lineas < 0 || visitantes == NULL || recursos == NULL) {
+        fprintf(stderr, "No se pudo preparar %s\n", nombre_archivo);
+        return 1;
+    }
+
+    struct timespec inicio;
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+    bool ok = procesar_logs(&nombre_archivo, 1, recursos, visitantes);
+    fflush(stdout);
+    double segundos_carga = segundos_desde(&inicio);
+
+    char desde[] = "0.0.0.0";
+    char hasta[] = "255.255.255.255";
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+    // En modo aproximado ver_visitantes no esta disponible y falla enseguida.
+    mostrar_visitantes(visitantes, desde, hasta);
+    fflush(stdout);
+    double segundos_visitantes = segundos_desde(&inicio);
+
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+    mostrar_mas_visitados(recursos, K_MAS_VISITADOS);
+    fflush(stdout);
+    double segundos_mas_visitados = segundos_desde(&inicio);
+
+    struct rusage uso;
+    getrusage(RUSAGE_SELF, &uso);
+    fprintf(resultados, "%-28s %12lld %10.3f %12.0f %12.4f %12.4f %10.1f %10zu\n",
+            nombre_archivo, lineas, segundos_carga, (double)lineas / segundos_carga,
+            segundos_visitantes, segundos_mas_visitados, (double)uso.ru_maxrss / 1024.0, visitantes_cantidad(visitantes));
+
+    recursos_destruir(recursos);
+    visitantes_destruir(visitantes);
+    return ok ? 0 : 1;
+}
+
+int main(int argc, char* argv[]) {
+
+    int primero = 1;
+    bool aproximado = argc > 1 && strcmp(argv[1], "-a") == 0;
+    if (aproximado) primero++;
+    if (primero >= argc) {
+        fprintf(stderr, "Uso: %s [-a] <log> [<log> ...]\n", argv[0]);
+        return 1;
+    }
+
+    printf("%-28s %12s %10s %12s %12s %12s %10s %10s\n", "archivo", "lineas", "carga(s)",
+           "lineas/s", "visitantes(s)", "top10(s)", "RSS(MB)", "ips");
+    fflush(stdout);
+    int resultado = 0;
+    for (int i = primero; i < argc; i++) {
+        pid_t hijo = fork();
+        if (hijo == -1) return 1;
+        if (hijo == 0) {
+            // La salida de los comandos se descarta; los resultados van por un duplicado de stdout.
+            FILE* resultados = fdopen(dup(STDOUT_FILENO), "w");
+            if (resultados == NULL || freopen("/dev/null", "w", stdout) == NULL) _exit(1);
+            int estado = medir_archivo(argv[i], aproximado, resultados);
+            fclose(resultados);
+            exit(estado);
+        }
+        int estado;
+        if (waitpid(hijo, &estado, 0) == -1 || !WIFEXITED(estado) || WEXITSTATUS(estado) != 0) {
+            fprintf(stderr, "Fallo la medicion de %s\n", argv[i]);
+            resultado = 1;
+        }
+    }
+    return resultado;
+}
@@ -0,0 +1,235 @@
+#define _XOPEN_SOURCE 700
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/*
+ * Generador de logs de acceso sinteticos con el formato de los access00*.log.
+ * Uso: ./generar_logs [-n lineas] [-i ips] [-r recursos] [-z exponente_zipf]
+ *                     [-d rafagas_dos] [-l lineas_por_segundo] [-t inicio] [-s semilla]
+ *                     [-6 fraccion_ipv6] [archivo]
+ * Sin archivo escribe por salida estandar. La popularidad de los recursos sigue una ley
+ * de Zipf (el recurso k se pide con probabilidad proporcional a 1 / k^exponente) y las ips
+ * se eligen uniformemente. Una fraccion de las ips (por defecto ninguna) son IPv6 dentro de
+ * 2001:db8::/32. Cada rafaga de DoS son SOLICITUDES_POR_RAFAGA pedidos de una
+ * misma ip en el mismo segundo; las rafagas se reparten al azar a lo largo del log.
+ */
+
+#define LINEAS_POR_DEFECTO 100000
+#define IPS_POR_DEFECTO 10000
+#define RECURSOS_POR_DEFECTO 10000
+#define EXPONENTE_ZIPF_POR_DEFECTO 1.0
+#define RAFAGAS_POR_DEFECTO 10
+#define LINEAS_POR_SEGUNDO_POR_DEFECTO 50
+#define INICIO_POR_DEFECTO 1431820800   // 2015-05-17T00:00:00Z, como los logs de ejemplo.
+#define SEMILLA_POR_DEFECTO 1
+#define FRACCION_IPV6_POR_DEFECTO 0.0
+
+#define SOLICITUDES_POR_RAFAGA 8
+#define TAM_FECHA 32
+#define TAM_BUFFER_SALIDA (1 << 16)
+
+typedef struct parametros {
+    unsigned long long lineas;
+    size_t ips;
+    size_t recursos;
+    double exponente_zipf;
+    unsigned long long rafagas;
+    unsigned long lineas_por_segundo;
+    time_t inicio;
+    uint64_t semilla;
+    double fraccion_ipv6;
+    const char* archivo;
+} parametros_t;
+
+//Ip de los logs generados: los bits al azar y si se escriben como IPv4 o como IPv6.
+typedef struct ip_generada {
+    uint64_t bits;
+    bool es_v6;
+} ip_generada_t;
+
+/*********************************** AZAR ***********************************/
+
+//Generador xorshift64*: rapido y reproducible a partir de la semilla.
+static uint64_t siguiente_azar(uint64_t* estado) {
+
+    *estado ^= *estado >> 12;
+    *estado ^= *estado << 25;
+    *estado ^= *estado >> 27;
+    return *estado * 0x2545F4914F6CDD1DULL;
+}
+
+//Devuelve un real uniforme en [0, 1).
+static double azar_uniforme(uint64_t* estado) {
+
+    return (double)(siguiente_azar(estado) >> 11) / (double)(1ULL << 53);
+}
+
+//Devuelve un entero uniforme en [0, limite).
+static uint64_t azar_hasta(uint64_t* estado, uint64_t limite) {
+
+    return siguiente_azar(estado) % limite;
+}
+
+/*********************************** ZIPF ***********************************/
+
+//Distribucion acumulada de Zipf sobre 'cantidad' recursos.
+static double* crear_acumulada_zipf(size_t cantidad, double exponente) {
+
+    double* acumulada = malloc(sizeof(double) * cantidad);
+    if (acumulada == NULL) return NULL;
+    double total = 0;
+    for (size_t k = 0; k < cantidad; k++) {
+        total += 1.0 / pow((double)(k + 1), exponente);
+        acumulada[k] = total;
+    }
+    for (size_t k = 0; k < cantidad; k++) acumulada[k] /= total;
+    return acumulada;
+}
+
+//Elige un recurso buscando binariamente un uniforme en la acumulada.
+static size_t elegir_recurso(const double* acumulada, size_t cantidad, uint64_t* estado) {
+
+    double u = azar_uniforme(estado);
+    size_t inicio = 0;
+    size_t fin = cantidad - 1;
+    while (inicio < fin) {
+        size_t medio = inicio + (fin - inicio) / 2;
+        if (acumulada[medio] < u) inicio = medio + 1;
+        else fin = medio;
+    }
+    return inicio;
+}
+
+/********************************** SALIDA **********************************/
+
+//Fecha ISO-8601 del ultimo segundo escrito, para no formatearla en cada linea.
+typedef struct fecha_cacheada {
+    time_t segundo;
+    char texto[TAM_FECHA];
+} fecha_cacheada_t;
+
+static const char* formatear_fecha(fecha_cacheada_t* fecha, time_t segundo) {
+
+    if (segundo != fecha->segundo || fecha->texto[0] == '\0') {
+        struct tm partes;
+        gmtime_r(&segundo, &partes);
+        strftime(fecha->texto, TAM_FECHA, "%Y-%m-%dT%H:%M:%S+00:00", &partes);
+        fecha->segundo = segundo;
+    }
+    return fecha->texto;
+}
+
+static void escribir_linea(FILE* salida, ip_generada_t ip, const char* fecha, size_t recurso) {
+
+    if (ip.es_v6) {
+        fprintf(salida, "2001:db8:%x:%x:%x:%x::\t%s\tGET\t/recurso/%zu\n",
+                (unsigned)(ip.bits >> 48) & 0xFFFF, (unsigned)(ip.bits >> 32) & 0xFFFF,
+                (unsigned)(ip.bits >> 16) & 0xFFFF, (unsigned)ip.bits & 0xFFFF, fecha, recurso);
+        return;
+    }
+    uint32_t v4 = (uint32_t)ip.bits;
+    fprintf(salida, "%u.%u.%u.%u\t%s\tGET\t/recurso/%zu\n",
+            v4 >> 24, (v4 >> 16) & 0xFF, (v4 >> 8) & 0xFF, v4 & 0xFF, fecha, recurso);
+}
+
+/******************************** PARAMETROS ********************************/
+
+static bool leer_parametros(int argc, char* argv[], parametros_t* parametros) {
+
+    parametros->lineas = LINEAS_POR_DEFECTO;
+    parametros->ips = IPS_POR_DEFECTO;
+    parametros->recursos = RECURSOS_POR_DEFECTO;
+    parametros->exponente_zipf = EXPONENTE_ZIPF_POR_DEFECTO;
+    parametros->rafagas = RAFAGAS_POR_DEFECTO;
+    parametros->lineas_por_segundo = LINEAS_POR_SEGUNDO_POR_DEFECTO;
+    parametros->inicio = INICIO_POR_DEFECTO;
+    parametros->semilla = SEMILLA_POR_DEFECTO;
+    parametros->fraccion_ipv6 = FRACCION_IPV6_POR_DEFECTO;
+    parametros->archivo = NULL;
+    int opcion;
+    while ((opcion = getopt(argc, argv, "n:i:r:z:d:l:t:s:6:")) != -1) {
+        switch (opcion) {
+            case 'n': parametros->lineas = strtoull(optarg, NULL, 10); break;
+            case 'i': parametros->ips = (size_t)strtoull(optarg, NULL, 10); break;
+            case 'r': parametros->recursos = (size_t)strtoull(optarg, NULL, 10); break;
+            case 'z': parametros->exponente_zipf = strtod(optarg, NULL); break;
+            case 'd': parametros->rafagas = strtoull(optarg, NULL, 10); break;
+            case 'l': parametros->lineas_por_segundo = strtoul(optarg, NULL, 10); break;
+            case 't': parametros->inicio = (time_t)strtoll(optarg, NULL, 10); break;
+            case 's': parametros->semilla = strtoull(optarg, NULL, 10); break;
+            case '6': parametros->fraccion_ipv6 = strtod(optarg, NULL); break;
+            default: return false;
+        }
+    }
+    if (optind < argc) parametros->archivo = argv[optind++];
+    return optind == argc && parametros->ips > 0 && parametros->recursos > 0
+        && parametros->lineas_por_segundo > 0 && parametros->exponente_zipf >= 0
+        && parametros->fraccion_ipv6 >= 0 && parametros->fraccion_ipv6 <= 1
+        && parametros->rafagas * SOLICITUDES_POR_RAFAGA <= parametros->lineas;
+}
+
+/*********************************** MAIN ***********************************/
+
+int main(int argc, char* argv[]) {
+
+    parametros_t parametros;
+    if (!leer_parametros(argc, argv, &parametros)) {
+        fprintf(stderr, "Uso: %s [-n lineas] [-i ips] [-r recursos] [-z exponente_zipf] [-d rafagas_dos]"
+                        " [-l lineas_por_segundo] [-t inicio] [-s semilla] [-6 fraccion_ipv6] [archivo]\n", argv[0]);
+        return 1;
+    }
+    uint64_t estado = parametros.semilla * 0x9E3779B97F4A7C15ULL + 1;
+    ip_generada_t* ips = malloc(sizeof(ip_generada_t) * parametros.ips);
+    double* acumulada = crear_acumulada_zipf(parametros.recursos, parametros.exponente_zipf);
+    FILE* salida = parametros.archivo != NULL ? fopen(parametros.archivo, "w") : stdout;
+    if (ips == NULL || acumulada == NULL || salida == NULL) {
+        fprintf(stderr, "No se pudo preparar la generacion\n");
+        free(ips);
+        free(acumulada);
+        if (salida != NULL && salida != stdout) fclose(salida);
+        return 1;
+    }
+    setvbuf(salida, NULL, _IOFBF, TAM_BUFFER_SALIDA);
+    for (size_t i = 0; i < parametros.ips; i++) {
+        ips[i].bits = siguiente_azar(&estado);
+        // Sin IPv6 no se consume azar, para que los logs sigan iguales a los de antes.
+        ips[i].es_v6 = parametros.fraccion_ipv6 > 0 && azar_uniforme(&estado) < parametros.fraccion_ipv6;
+    }
+
+    // Las rafagas se intercalan entre las lineas normales con probabilidad uniforme.
+    unsigned long long rafagas_restantes = parametros.rafagas;
+    unsigned long long normales_restantes = parametros.lineas - parametros.rafagas * SOLICITUDES_POR_RAFAGA;
+    fecha_cacheada_t fecha = { .segundo = 0, .texto = "" };
+    unsigned long long escritas = 0;
+    while (rafagas_restantes > 0 || normales_restantes > 0) {
+        time_t segundo = parametros.inicio + (time_t)(escritas / parametros.lineas_por_segundo);
+        const char* texto_fecha = formatear_fecha(&fecha, segundo);
+        if (rafagas_restantes > 0 && azar_hasta(&estado, rafagas_restantes + normales_restantes) < rafagas_restantes) {
+            ip_generada_t atacante = ips[azar_hasta(&estado, parametros.ips)];
+            for (int i = 0; i < SOLICITUDES_POR_RAFAGA; i++) {
+                escribir_linea(salida, atacante, texto_fecha, elegir_recurso(acumulada, parametros.recursos, &estado));
+            }
+            rafagas_restantes--;
+            escritas += SOLICITUDES_POR_RAFAGA;
+        } else {
+            ip_generada_t ip = ips[azar_hasta(&estado, parametros.ips)];
+            escribir_linea(salida, ip, texto_fecha, elegir_recurso(acumulada, parametros.recursos, &estado));
+            normales_restantes--;
+            escritas++;
+        }
+    }
+
+    bool ok = !ferror(salida);
+    if (salida != stdout) ok = fclose(salida) == 0 && ok;
+    else ok = fflush(salida) == 0 && ok;
+    free(ips);
+    free(acumulada);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,70 @@
+#ifndef COLA_H
+#define COLA_H
+
+#include <stdbool.h>
+
+
+/* ******************************************************************
+ *                DEFINICION DE LOS TIPOS DE DATOS
+ * *****************************************************************/
+
+/* La cola está planteada como una cola de punteros genéricos. */
+
+struct cola;
+typedef struct cola cola_t;
+
+
+/* ******************************************************************
+ *                    PRIMITIVAS DE LA COLA
+ * *****************************************************************/
+
+// Crea una cola.
+// Post: devuelve una nueva cola vacía.
+cola_t* cola_crear(void);
+
+// Destruye la cola. Si se recibe la función destruir_dato por parámetro,
+// para cada uno de los elementos de la cola llama a destruir_dato.
+// Pre: la cola fue creada. destruir_dato es una función capaz de destruir
+// los datos de la cola, o NULL en caso de que no se la utilice.
+// Post: se eliminaron todos los elementos de la cola.
+void cola_destruir(cola_t *cola, void destruir_dato(void*));
+
+// Devuelve verdadero o falso, según si la cola tiene o no elementos encolados.
+// Pre: la cola fue creada.
+bool cola_esta_vacia(const cola_t *cola);
+
+// Agrega un nuevo elemento a la cola. Devuelve falso en caso de error.
+// Pre: la cola fue creada.
+// Post: se agregó un nuevo elemento a la cola, valor se encuentra al final
+// de la cola.
+bool cola_encolar(cola_t *cola, void* valor);
+
+// Obtiene el valor del primer elemento de la cola. Si la cola tiene
+// elementos, se devuelve el valor del primero, si está vacía devuelve NULL.
+// Pre: la cola fue creada.
+// Post: se devolvió el primer elemento de la cola, cuando no está vacía.
+void* cola_ver_primero(const cola_t *cola);
+
+// Saca el primer elemento de la cola. Si la cola tiene elementos, se quita el
+// primero de la cola, y se devuelve su valor, si está vacía, devuelve NULL.
+// Pre: la cola fue creada.
+// Post: se devolvió el valor del primer elemento anterior, la cola
+// contiene un elemento menos, si la cola no estaba vacía.
+void* cola_desencolar(cola_t *cola);
+
+
+/* *****************************************************************
+ *                      PRUEBAS UNITARIAS
+ * *****************************************************************/
+
+// Realiza pruebas sobre la implementación del alumno.
+//
+// Las pruebas deben emplazarse en el archivo ‘pruebas_alumno.c’, y
+// solamente pueden emplear la interfaz pública tal y como aparece en cola.h
+// (esto es, las pruebas no pueden acceder a los miembros del struct cola).
+//
+// Para la implementación de las pruebas se debe emplear la función
+// print_test(), como se ha visto en TPs anteriores.
+void pruebas_cola_alumno(void);
+
+#endif // COLA_H
@@ -0,0 +1,79 @@
+#include <pthread.h>
+#include <stdlib.h>
+#include "cola.h"
+#include "cola_bloqueante.h"
+
+struct cola_bloqueante {
+    cola_t* datos;
+    size_t cantidad;
+    size_t capacidad;
+    size_t productores;     // Los que todavia no la cerraron.
+    pthread_mutex_t mutex;
+    pthread_cond_t hay_lugar;
+    pthread_cond_t hay_datos;
+};
+
+/************************************************************************************/
+
+cola_bloqueante_t* cola_bloqueante_crear(size_t capacidad, size_t productores) {
+
+    cola_bloqueante_t* cola = malloc(sizeof(cola_bloqueante_t));
+    if (cola == NULL) return NULL;
+    cola->datos = cola_crear();
+    if (cola->datos == NULL) {
+        free(cola);
+        return NULL;
+    }
+    cola->cantidad = 0;
+    cola->capacidad = capacidad;
+    cola->productores = productores;
+    pthread_mutex_init(&cola->mutex, NULL);
+    pthread_cond_init(&cola->hay_lugar, NULL);
+    pthread_cond_init(&cola->hay_datos, NULL);
+    return cola;
+}
+
+bool cola_bloqueante_encolar(cola_bloqueante_t* cola, void* dato) {
+
+    pthread_mutex_lock(&cola->mutex);
+    while (cola->cantidad == cola->capacidad) pthread_cond_wait(&cola->hay_lugar, &cola->mutex);
+    bool ok = cola_encolar(cola->datos, dato);
+    if (ok) {
+        cola->cantidad++;
+        pthread_cond_signal(&cola->hay_datos);
+    }
+    pthread_mutex_unlock(&cola->mutex);
+    return ok;
+}
+
+void* cola_bloqueante_desencolar(cola_bloqueante_t* cola) {
+
+    pthread_mutex_lock(&cola->mutex);
+    while (cola->cantidad == 0 && cola->productores > 0) pthread_cond_wait(&cola->hay_datos, &cola->mutex);
+    void* dato = cola_desencolar(cola->datos);
+    if (dato != NULL) {
+        cola->cantidad--;
+        pthread_cond_signal(&cola->hay_lugar);
+    }
+    pthread_mutex_unlock(&cola->mutex);
+    return dato;
+}
+
+void cola_bloqueante_cerrar(cola_bloqueante_t* cola) {
+
+    pthread_mutex_lock(&cola->mutex);
+    if (cola->productores > 0) cola->productores--;
+    // Los consumidores que esperan tienen que enterarse de que ya no llegara nada.
+    if (cola->productores == 0) pthread_cond_broadcast(&cola->hay_datos);
+    pthread_mutex_unlock(&cola->mutex);
+}
+
+void cola_bloqueante_destruir(cola_bloqueante_t* cola, void destruir_dato(void*)) {
+
+    if (cola == NULL) return;
+    cola_destruir(cola->datos, destruir_dato);
+    pthread_mutex_destroy(&cola->mutex);
+    pthread_cond_destroy(&cola->hay_lugar);
+    pthread_cond_destroy(&cola->hay_datos);
+    free(cola);
+}
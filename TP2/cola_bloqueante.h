@@ -0,0 +1,34 @@
+#ifndef ALGOS_GITHUB_COLA_BLOQUEANTE_H
+#define ALGOS_GITHUB_COLA_BLOQUEANTE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+//Cola de capacidad acotada para pasar datos entre hilos, construida sobre cola_t.
+//Encolar espera mientras la cola esta llena y desencolar, mientras esta vacia.
+//Cada productor la cierra al terminar; cuando la cerraron todos y se vacio,
+//desencolar devuelve NULL, asi que no se pueden encolar punteros NULL.
+typedef struct cola_bloqueante cola_bloqueante_t;
+/************************************************************************************/
+
+//Crea una cola vacia con lugar para 'capacidad' elementos, que se da por terminada
+//cuando la cierran 'productores' veces. Devuelve NULL si no se pudo crear.
+cola_bloqueante_t* cola_bloqueante_crear(size_t capacidad, size_t productores);
+
+//Agrega el dato al final, esperando a que haya lugar.
+//Pre: 'dato' no es NULL y quien encola no cerro la cola.
+//Devuelve false si no se pudo encolar.
+bool cola_bloqueante_encolar(cola_bloqueante_t* cola, void* dato);
+
+//Saca el primer dato, esperando a que haya alguno.
+//Devuelve NULL si la cola esta vacia y ya la cerraron todos los productores.
+void* cola_bloqueante_desencolar(cola_bloqueante_t* cola);
+
+//Indica que uno de los productores no va a encolar mas.
+void cola_bloqueante_cerrar(cola_bloqueante_t* cola);
+
+//Destruye la cola, aplicando destruir_dato (si no es NULL) a los datos que queden.
+//Pre: ningun hilo la esta usando.
+void cola_bloqueante_destruir(cola_bloqueante_t* cola, void destruir_dato(void*));
+
+#endif //ALGOS_GITHUB_COLA_BLOQUEANTE_H
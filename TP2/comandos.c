@@ -1,63 +1,810 @@
 #define _XOPEN_SOURCE 700
 
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <zlib.h>
 #include "comandos.h"
+#include "cola_bloqueante.h"
 
-#define TIME_FORMAT "%FT%T%z"
+#define TAM_BUFFER_SEGUIMIENTO (1 << 16)
+
+//Procesamiento en etapas: tamanio de lo que lee el lector de una vez, tamanio minimo de
+//archivo para que convenga y pedazos en circulacion por cada hilo parseador.
+#define TAM_TROZO (1 << 20)
+#define TAM_MINIMO_ETAPAS (8 * TAM_TROZO)
+#define TROZOS_POR_PARSEADOR 2
+#define CAPACIDAD_INICIAL_SOLICITUDES 1024
+#define TAM_BUFFER_GZIP (1 << 18)
+#define MAGIA_GZIP "\x1f\x8b"
+#define LARGO_MAGIA_GZIP 2
 /***********************************************************************************************/
 
-bool procesar_log(char* nombre_de_archivo, hash_t* recursos_mas_solicitados, abb_t* visitantes) {
-    
-    FILE* archivo = fopen(nombre_de_archivo, "r");
-    if(archivo == NULL) return false;
+//Estado que se comparte entre las lineas de un mismo archivo de log.
+typedef struct procesamiento {
+    recursos_t* recursos_mas_solicitados;
+    visitantes_t* visitantes;
+    detector_dos_t* detector;
+    visitantes_t* DoS;
+    cache_fecha_t cache_fecha;
+    buffer_campo_t recurso;
+} procesamiento_t;
+
+//Linea del log ya parseada. El recurso apunta dentro de la linea.
+typedef struct solicitud {
+    ip_t ip;
+    time_t instante;
+    campo_t recurso;
+    bool fecha_valida;
+} solicitud_t;
+
+//Parsea una linea del log (sin el salto de linea). Devuelve false si esta mal formada.
+static bool parsear_solicitud(const char* linea, size_t largo, cache_fecha_t* cache_fecha, solicitud_t* solicitud) {
+
+    registro_t registro;
+    ESTADISTICAS_SUMAR(CONTADOR_LINEAS, 1);
+    if (!parsear_registro(linea, largo, &registro) || !ip_parsear(registro.ip.inicio, registro.ip.largo, &solicitud->ip)) {
+        ESTADISTICAS_SUMAR(CONTADOR_LINEAS_DESCARTADAS, 1);
+        return false;
+    }
+    solicitud->recurso = registro.recurso;
+    solicitud->fecha_valida = iso8601_a_tiempo(registro.fecha.inicio, registro.fecha.largo, cache_fecha, &solicitud->instante);
+    ESTADISTICAS_SUMAR(solicitud->fecha_valida ? CONTADOR_FECHAS_CONVERTIDAS : CONTADOR_FECHAS_INVALIDAS, 1);
+    return true;
+}
+
+//Guarda la solicitud en las estructuras. Solo se copian las claves que efectivamente se guardan.
+static void agregar_solicitud(procesamiento_t* procesamiento, const solicitud_t* solicitud) {
+
+    const char* nombre_recurso = campo_a_cadena(solicitud->recurso, &procesamiento->recurso);
+    if (nombre_recurso == NULL) return;
+
+    visitantes_guardar(procesamiento->visitantes, solicitud->ip);
+    // Una fecha invalida no impide contar la visita, pero no se la considera para DoS.
+    // Tampoco se la indexa por minuto.
+    if (solicitud->fecha_valida) {
+        detector_dos_registrar(procesamiento->detector, solicitud->ip, solicitud->instante, procesamiento->DoS);
+    }
+    registrar_visita_recurso(procesamiento->recursos_mas_solicitados, nombre_recurso, solicitud->ip,
+                             solicitud->fecha_valida ? &solicitud->instante : NULL);
+}
+
+//Procesa una linea del log (sin el salto de linea). Las lineas mal formadas se ignoran.
+static void procesar_linea(procesamiento_t* procesamiento, const char* linea, size_t largo) {
+
+    solicitud_t solicitud;
+    if (parsear_solicitud(linea, largo, &procesamiento->cache_fecha, &solicitud)) agregar_solicitud(procesamiento, &solicitud);
+}
+
+//Recorre un bloque de memoria con el contenido del log, linea por linea.
+static void procesar_bloque(procesamiento_t* procesamiento, const char* datos, size_t largo) {
+
+    const char* actual = datos;
+    const char* fin = datos + largo;
+    while (actual < fin) {
+        const char* salto = memchr(actual, '\n', (size_t)(fin - actual));
+        const char* fin_linea = salto != NULL ? salto : fin;
+        procesar_linea(procesamiento, actual, (size_t)(fin_linea - actual));
+        actual = fin_linea + 1;
+    }
+}
+
+//Proyecta el archivo en memoria y lo procesa sin copiarlo.
+//Devuelve false si el archivo no se pudo proyectar (por ejemplo, si no es un archivo regular).
+static bool procesar_log_mapeado(procesamiento_t* procesamiento, int descriptor) {
+
+    struct stat informacion;
+    if (fstat(descriptor, &informacion) == -1 || !S_ISREG(informacion.st_mode)) return false;
+    size_t largo = (size_t)informacion.st_size;
+    if (largo == 0) return true;
+
+    void* datos = mmap(NULL, largo, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    if (datos == MAP_FAILED) return false;
+    posix_madvise(datos, largo, POSIX_MADV_SEQUENTIAL);
+    ESTADISTICAS_SUMAR(CONTADOR_BYTES_LEIDOS, largo);
+    procesar_bloque(procesamiento, datos, largo);
+    munmap(datos, largo);
+    return true;
+}
+
+//Lee el archivo linea por linea. Se usa cuando no se lo puede proyectar en memoria.
+static void procesar_log_secuencial(procesamiento_t* procesamiento, FILE* archivo) {
+
     char *linea = NULL;
     size_t capacidad = 0;
     ssize_t leidos;
+    while ((leidos = getline(&linea, &capacidad, archivo)) > 0) {
+        size_t largo = (size_t)leidos;
+        ESTADISTICAS_SUMAR(CONTADOR_BYTES_LEIDOS, largo);
+        if (linea[largo - 1] == '\n') largo--;
+        procesar_linea(procesamiento, linea, largo);
+    }
+    free(linea);
+}
 
-    abb_t* DoS = abb_crear(comparar_ips, NULL);
+/************************************ PROCESAMIENTO EN ETAPAS ************************************/
 
-    hash_t* peticiones_por_ip = hash_crear((hash_destruir_dato_t)wrapper_destruir_hash_solicitudes);
-    if (peticiones_por_ip == NULL) return false;
+//Pedazo del archivo con lineas completas. Va del lector a un parseador, de ahi al agregador,
+//y vuelve a los libres para reusarse, asi que no se reservan buffers durante la carga.
+typedef struct trozo {
+    size_t secuencia;       // Orden en el archivo.
+    char* datos;
+    size_t largo;
+    size_t capacidad;
+    solicitud_t* solicitudes;
+    size_t cant_solicitudes;
+    size_t cap_solicitudes;
+    bool error;
+} trozo_t;
 
-    while ((leidos = getline(&linea, &capacidad, archivo)) > 0) {
-        quitar_caracter_new_line(linea);
-        char **linea_a_procesar = split(linea, '\t');
-        char *ip = linea_a_procesar[0];
-        char *nombre_recurso = linea_a_procesar[3];
-        time_t* instante = malloc(sizeof(time_t));
-        *instante = iso8601_to_time(linea_a_procesar[1]);
-
-        abb_guardar(visitantes, ip, NULL);
-        agregar_fecha_de_solicitud(ip, instante, peticiones_por_ip);
-        aumenta_cont_solicitudes_recurso(recursos_mas_solicitados, nombre_recurso);
-        free_strv(linea_a_procesar);
-    }
-    identificar_posibles_DOS(peticiones_por_ip, DoS);
-    abb_in_order(DoS, imprimir_dos, NULL);
-    abb_destruir(DoS);
-    hash_destruir(peticiones_por_ip);
-    free(linea);
-    fclose(archivo);
+//Un lector, varios parseadores y un agregador conectados por colas. Las colas tienen lugar
+//para todos los trozos, asi que encolar nunca espera: lo que limita la memoria es que el
+//lector solo avanza cuando el agregador le devuelve un trozo libre.
+typedef struct etapas {
+    int descriptor;
+    gzFile comprimido;      // Si no es NULL, el lector descomprime de aca en lugar de leer el descriptor.
+    trozo_t* trozos;
+    size_t cant_trozos;
+    cola_bloqueante_t* libres;
+    cola_bloqueante_t* para_parsear;
+    cola_bloqueante_t* parseados;
+    trozo_t** adelantados;  // Del agregador; se reserva antes de lanzar los hilos.
+    bool error_lectura;
+} etapas_t;
+
+static bool asegurar_capacidad_trozo(trozo_t* trozo, size_t capacidad) {
+
+    if (trozo->capacidad >= capacidad) return true;
+    char* datos = realloc(trozo->datos, capacidad);
+    if (datos == NULL) return false;
+    trozo->datos = datos;
+    trozo->capacidad = capacidad;
+    return true;
+}
+
+//Lee hasta llenar 'largo' bytes (a lo sumo UINT_MAX) o llegar al final del archivo,
+//descomprimiendo si hace falta. Devuelve lo leido, o -1 si fallo.
+static ssize_t leer_completo(etapas_t* etapas, char* destino, size_t largo) {
+
+    size_t total = 0;
+    while (total < largo) {
+        if (etapas->comprimido != NULL) {
+            int descomprimidos = gzread(etapas->comprimido, destino + total, (unsigned)(largo - total));
+            if (descomprimidos < 0) return -1;
+            if (descomprimidos == 0) {
+                // Un gzip cortado tambien termina asi, pero queda marcado como error.
+                int error;
+                gzerror(etapas->comprimido, &error);
+                if (error != Z_OK) return -1;
+                break;
+            }
+            total += (size_t)descomprimidos;
+            continue;
+        }
+        ssize_t leidos = read(etapas->descriptor, destino + total, largo - total);
+        if (leidos < 0 && errno == EINTR) continue;
+        if (leidos < 0) return -1;
+        if (leidos == 0) break;
+        total += (size_t)leidos;
+    }
+    return (ssize_t)total;
+}
 
+//Etapa lectora: llena trozos libres con lineas completas. Lo que sigue al ultimo salto de
+//linea se guarda en un buffer propio del lector, que se reusa, y va al principio del trozo siguiente.
+static void* leer_trozos(void* dato) {
+
+    etapas_t* etapas = dato;
+    char* resto = NULL;
+    size_t largo_resto = 0;
+    size_t capacidad_resto = 0;
+    size_t secuencia = 0;
+    bool fin = false;
+    while (!fin) {
+        trozo_t* trozo = cola_bloqueante_desencolar(etapas->libres);
+        if (!asegurar_capacidad_trozo(trozo, largo_resto + TAM_TROZO)) {
+            etapas->error_lectura = true;
+            break;
+        }
+        if (largo_resto > 0) memcpy(trozo->datos, resto, largo_resto);
+        ssize_t leidos = leer_completo(etapas, trozo->datos + largo_resto, TAM_TROZO);
+        if (leidos < 0) {
+            etapas->error_lectura = true;
+            break;
+        }
+        ESTADISTICAS_SUMAR(CONTADOR_BYTES_LEIDOS, (size_t)leidos);
+        trozo->largo = largo_resto + (size_t)leidos;
+        fin = (size_t)leidos < TAM_TROZO;
+
+        size_t completas = trozo->largo;
+        if (!fin) {
+            while (completas > 0 && trozo->datos[completas - 1] != '\n') completas--;
+        }
+        // Sin ningun salto de linea, todo el trozo es el principio de una linea larga.
+        size_t nuevo_resto = completas == 0 ? trozo->largo : trozo->largo - completas;
+        if (nuevo_resto > capacidad_resto) {
+            char* mayor = realloc(resto, nuevo_resto);
+            if (mayor == NULL) {
+                etapas->error_lectura = true;
+                break;
+            }
+            resto = mayor;
+            capacidad_resto = nuevo_resto;
+        }
+        if (nuevo_resto > 0) memcpy(resto, trozo->datos + trozo->largo - nuevo_resto, nuevo_resto);
+        largo_resto = nuevo_resto;
+        if (completas == 0) {
+            cola_bloqueante_encolar(etapas->libres, trozo);
+            continue;
+        }
+        trozo->largo = completas;
+        trozo->secuencia = secuencia++;
+        cola_bloqueante_encolar(etapas->para_parsear, trozo);
+    }
+    free(resto);
+    cola_bloqueante_cerrar(etapas->para_parsear);
+    ESTADISTICAS_VOLCAR_HILO();
+    return NULL;
+}
+
+//Parsea todas las lineas del trozo. Si no hay memoria para guardarlas, el trozo queda con error.
+static void parsear_trozo(trozo_t* trozo, cache_fecha_t* cache_fecha) {
+
+    trozo->cant_solicitudes = 0;
+    trozo->error = false;
+    const char* actual = trozo->datos;
+    const char* fin = trozo->datos + trozo->largo;
+    while (actual < fin) {
+        const char* salto = memchr(actual, '\n', (size_t)(fin - actual));
+        const char* fin_linea = salto != NULL ? salto : fin;
+        if (trozo->cant_solicitudes == trozo->cap_solicitudes) {
+            size_t capacidad = trozo->cap_solicitudes == 0 ? CAPACIDAD_INICIAL_SOLICITUDES : trozo->cap_solicitudes * 2;
+            solicitud_t* solicitudes = realloc(trozo->solicitudes, sizeof(solicitud_t) * capacidad);
+            if (solicitudes == NULL) {
+                trozo->error = true;
+                return;
+            }
+            trozo->solicitudes = solicitudes;
+            trozo->cap_solicitudes = capacidad;
+        }
+        if (parsear_solicitud(actual, (size_t)(fin_linea - actual), cache_fecha, &trozo->solicitudes[trozo->cant_solicitudes])) {
+            trozo->cant_solicitudes++;
+        }
+        actual = fin_linea + 1;
+    }
+}
+
+//Etapa parseadora: cada hilo tiene su propia cache de fechas.
+static void* parsear_trozos(void* dato) {
+
+    etapas_t* etapas = dato;
+    cache_fecha_t cache_fecha;
+    cache_fecha_inicializar(&cache_fecha);
+    trozo_t* trozo;
+    while ((trozo = cola_bloqueante_desencolar(etapas->para_parsear)) != NULL) {
+        parsear_trozo(trozo, &cache_fecha);
+        cola_bloqueante_encolar(etapas->parseados, trozo);
+    }
+    cola_bloqueante_cerrar(etapas->parseados);
+    ESTADISTICAS_VOLCAR_HILO();
+    return NULL;
+}
+
+//Etapa agregadora, en el hilo que llama: guarda las solicitudes en el orden del archivo, que es
+//el que necesita la deteccion de DoS. Los trozos en circulacion tienen secuencias consecutivas,
+//asi que los que llegan adelantados esperan en la posicion secuencia % cant_trozos.
+static bool agregar_trozos(etapas_t* etapas, procesamiento_t* procesamiento) {
+
+    trozo_t** adelantados = etapas->adelantados;
+    size_t proxima = 0;
+    bool ok = true;
+    trozo_t* trozo;
+    while ((trozo = cola_bloqueante_desencolar(etapas->parseados)) != NULL) {
+        adelantados[trozo->secuencia % etapas->cant_trozos] = trozo;
+        while ((trozo = adelantados[proxima % etapas->cant_trozos]) != NULL) {
+            adelantados[proxima % etapas->cant_trozos] = NULL;
+            for (size_t i = 0; i < trozo->cant_solicitudes; i++) agregar_solicitud(procesamiento, &trozo->solicitudes[i]);
+            ok = ok && !trozo->error;
+            proxima++;
+            cola_bloqueante_encolar(etapas->libres, trozo);
+        }
+    }
+    // Si se perdio algun trozo, quedan adelantados sin agregar.
+    for (size_t i = 0; i < etapas->cant_trozos; i++) ok = ok && adelantados[i] == NULL;
+    return ok;
+}
+
+static void destruir_etapas(etapas_t* etapas) {
+
+    cola_bloqueante_destruir(etapas->libres, NULL);
+    cola_bloqueante_destruir(etapas->para_parsear, NULL);
+    cola_bloqueante_destruir(etapas->parseados, NULL);
+    for (size_t i = 0; etapas->trozos != NULL && i < etapas->cant_trozos; i++) {
+        free(etapas->trozos[i].datos);
+        free(etapas->trozos[i].solicitudes);
+    }
+    free(etapas->trozos);
+    free(etapas->adelantados);
+    if (etapas->comprimido != NULL) gzclose(etapas->comprimido);
+}
+
+//Devuelve true si el archivo empieza como un gzip.
+static bool es_gzip(int descriptor) {
+
+    char magia[LARGO_MAGIA_GZIP];
+    return pread(descriptor, magia, LARGO_MAGIA_GZIP, 0) == LARGO_MAGIA_GZIP && memcmp(magia, MAGIA_GZIP, LARGO_MAGIA_GZIP) == 0;
+}
+
+//Prepara la descompresion sobre una copia del descriptor, porque gzclose la cierra.
+static gzFile abrir_comprimido(int descriptor) {
+
+    int copia = dup(descriptor);
+    if (copia == -1) return NULL;
+    gzFile comprimido = gzdopen(copia, "rb");
+    if (comprimido == NULL) {
+        close(copia);
+        return NULL;
+    }
+    gzbuffer(comprimido, TAM_BUFFER_GZIP);
+    return comprimido;
+}
+
+//Procesa el archivo con un hilo lector, 'parseadores' hilos parseadores y el agregador en
+//el hilo actual, asi la lectura y el parseo se superponen con la carga en las estructuras.
+//Si el archivo es un gzip, el lector lo descomprime mientras los demas trabajan.
+//Devuelve false, sin haber leido nada, si no se pudo armar; en ese caso *ok no se modifica.
+static bool procesar_log_en_etapas(procesamiento_t* procesamiento, int descriptor, bool comprimido, size_t parseadores, bool* ok) {
+
+    etapas_t etapas = { .descriptor = descriptor, .cant_trozos = parseadores * TROZOS_POR_PARSEADOR + 2 };
+    etapas.comprimido = comprimido ? abrir_comprimido(descriptor) : NULL;
+    etapas.trozos = calloc(etapas.cant_trozos, sizeof(trozo_t));
+    etapas.adelantados = calloc(etapas.cant_trozos, sizeof(trozo_t*));
+    etapas.libres = cola_bloqueante_crear(etapas.cant_trozos, 1);
+    etapas.para_parsear = cola_bloqueante_crear(etapas.cant_trozos, 1);
+    etapas.parseados = cola_bloqueante_crear(etapas.cant_trozos, parseadores);
+    pthread_t* hilos = malloc(sizeof(pthread_t) * (parseadores + 1));
+    bool armado = (!comprimido || etapas.comprimido != NULL) && etapas.trozos != NULL && etapas.adelantados != NULL && etapas.libres != NULL && etapas.para_parsear != NULL
+        && etapas.parseados != NULL && hilos != NULL;
+    for (size_t i = 0; armado && i < etapas.cant_trozos; i++) armado = cola_bloqueante_encolar(etapas.libres, &etapas.trozos[i]);
+
+    // Si no se pueden lanzar todos los parseadores, se trabaja con los que haya.
+    size_t lanzados = 0;
+    while (armado && lanzados < parseadores && pthread_create(&hilos[lanzados + 1], NULL, parsear_trozos, &etapas) == 0) lanzados++;
+    for (size_t i = lanzados; armado && i < parseadores; i++) cola_bloqueante_cerrar(etapas.parseados);
+    armado = armado && lanzados > 0 && pthread_create(&hilos[0], NULL, leer_trozos, &etapas) == 0;
+    if (!armado) {
+        // Los parseadores lanzados terminan apenas se cierra la cola de trozos a parsear.
+        cola_bloqueante_cerrar(etapas.para_parsear);
+        for (size_t i = 0; i < lanzados; i++) pthread_join(hilos[i + 1], NULL);
+        free(hilos);
+        destruir_etapas(&etapas);
+        return false;
+    }
+
+    bool agregado = agregar_trozos(&etapas, procesamiento);
+    for (size_t i = 0; i <= lanzados; i++) pthread_join(hilos[i], NULL);
+    *ok = agregado && !etapas.error_lectura;
+    free(hilos);
+    destruir_etapas(&etapas);
     return true;
 }
 
-void mostrar_mas_visitados(hash_t* recursos_mas_solicitados, int cantidad_de_recursos_a_mostrar){
+/************************************************************************************************/
+
+//Procesa un archivo ya abierto, guardando recursos y visitantes en las estructuras recibidas
+//y las ips sospechosas de DoS en el conjunto 'DoS'. La deteccion de DoS es propia de cada archivo.
+//Los archivos grandes se procesan en etapas si hay 'parseadores' hilos disponibles, y los
+//comprimidos con gzip siempre, para descomprimir en un hilo aparte sin archivos temporales.
+//'simultaneos' es la cantidad de archivos que se procesan a la vez, que comparten el limite
+//de memoria de la deteccion de DoS.
+static bool procesar_archivo(FILE* archivo, recursos_t* recursos_mas_solicitados, visitantes_t* visitantes, visitantes_t* DoS, size_t parseadores, size_t simultaneos) {
+
+    ESTADISTICAS_INICIO(inicio);
+    detector_dos_t* detector = detector_dos_crear(simultaneos);
+    if (detector == NULL) return false;
+    procesamiento_t procesamiento = {
+        .recursos_mas_solicitados = recursos_mas_solicitados,
+        .visitantes = visitantes,
+        .detector = detector,
+        .DoS = DoS,
+    };
+    cache_fecha_inicializar(&procesamiento.cache_fecha);
+
+    bool ok = true;
+    if (es_gzip(fileno(archivo))) {
+        ok = procesar_log_en_etapas(&procesamiento, fileno(archivo), true, parseadores > 0 ? parseadores : 1, &ok) && ok;
+    } else {
+        struct stat informacion;
+        bool en_etapas = parseadores > 0 && fstat(fileno(archivo), &informacion) == 0 && S_ISREG(informacion.st_mode)
+            && informacion.st_size >= TAM_MINIMO_ETAPAS && procesar_log_en_etapas(&procesamiento, fileno(archivo), false, parseadores, &ok);
+        if (!en_etapas && !procesar_log_mapeado(&procesamiento, fileno(archivo))) {
+            procesar_log_secuencial(&procesamiento, archivo);
+        }
+    }
+
+    ok = detector_dos_finalizar(detector, DoS) && ok;
+    detector_dos_destruir(detector);
+    buffer_campo_destruir(&procesamiento.recurso);
+    ESTADISTICAS_REGISTRAR(MEDICION_ARCHIVO, inicio);
+    return ok;
+}
+
+//Archivos pendientes de un mismo comando, que los hilos se van repartiendo.
+typedef struct trabajo_logs {
+    FILE** archivos;
+    visitantes_t** DoS;
+    size_t cantidad;
+    size_t proximo;
+    size_t parseadores;     // Hilos parseadores que puede usar cada archivo, ademas del de su trabajador.
+    size_t hilos;           // Archivos que se procesan a la vez.
+    pthread_mutex_t mutex;
+} trabajo_logs_t;
+
+//Cada hilo acumula sus propios recursos y visitantes, que se fusionan al final.
+typedef struct trabajador {
+    pthread_t hilo;
+    trabajo_logs_t* trabajo;
+    recursos_t* recursos;
+    visitantes_t* visitantes;
+    bool ok;
+} trabajador_t;
 
+//Toma archivos pendientes hasta que no quede ninguno.
+static void* trabajar(void* dato) {
+
+    trabajador_t* trabajador = dato;
+    trabajo_logs_t* trabajo = trabajador->trabajo;
+    while (true) {
+        pthread_mutex_lock(&trabajo->mutex);
+        size_t actual = trabajo->proximo++;
+        pthread_mutex_unlock(&trabajo->mutex);
+        if (actual >= trabajo->cantidad) break;
+        if (!procesar_archivo(trabajo->archivos[actual], trabajador->recursos, trabajador->visitantes, trabajo->DoS[actual], trabajo->parseadores, trabajo->hilos)) {
+            trabajador->ok = false;
+        }
+    }
+    ESTADISTICAS_VOLCAR_HILO();
+    return NULL;
+}
+
+static size_t cantidad_de_procesadores(void) {
+
+    long procesadores = sysconf(_SC_NPROCESSORS_ONLN);
+    return procesadores > 0 ? (size_t)procesadores : 1;
+}
+
+//Cantidad de hilos a usar: uno por archivo, sin superar la cantidad de procesadores.
+static size_t cantidad_de_hilos(size_t cantidad_archivos) {
+
+    size_t hilos = cantidad_de_procesadores();
+    return hilos < cantidad_archivos ? hilos : cantidad_archivos;
+}
+
+//Reparte los archivos entre los hilos. Con un solo hilo se procesa directamente sobre
+//las estructuras globales; si no, cada hilo usa las suyas y despues se fusionan.
+static bool procesar_en_paralelo(trabajo_logs_t* trabajo, recursos_t* recursos_mas_solicitados, visitantes_t* visitantes) {
+
+    size_t cantidad = cantidad_de_hilos(trabajo->cantidad);
+    trabajo->hilos = cantidad > 0 ? cantidad : 1;
+    // Los procesadores que sobran se reparten como parseadores entre los archivos en curso.
+    trabajo->parseadores = cantidad_de_procesadores() / (cantidad > 0 ? cantidad : 1) - 1;
+    if (cantidad <= 1) {
+        trabajador_t trabajador = { .trabajo = trabajo, .recursos = recursos_mas_solicitados, .visitantes = visitantes, .ok = true };
+        trabajar(&trabajador);
+        return trabajador.ok;
+    }
+
+    trabajador_t* trabajadores = calloc(cantidad, sizeof(trabajador_t));
+    if (trabajadores == NULL) return false;
+    size_t lanzados = 0;
+    for (; lanzados < cantidad; lanzados++) {
+        trabajador_t* trabajador = &trabajadores[lanzados];
+        trabajador->trabajo = trabajo;
+        trabajador->ok = true;
+        trabajador->recursos = recursos_crear_como(recursos_mas_solicitados);
+        trabajador->visitantes = visitantes_crear_como(visitantes);
+        if (trabajador->recursos == NULL || trabajador->visitantes == NULL
+            || pthread_create(&trabajador->hilo, NULL, trabajar, trabajador) != 0) {
+            if (trabajador->recursos != NULL) recursos_destruir(trabajador->recursos);
+            visitantes_destruir(trabajador->visitantes);
+            break;
+        }
+    }
+    // Si no se pudieron lanzar todos los hilos, los lanzados igual procesan todos los archivos.
+    bool ok = lanzados > 0;
+    if (lanzados == 0) {
+        trabajador_t trabajador = { .trabajo = trabajo, .recursos = recursos_mas_solicitados, .visitantes = visitantes, .ok = true };
+        trabajar(&trabajador);
+        ok = trabajador.ok;
+    }
+    for (size_t i = 0; i < lanzados; i++) {
+        pthread_join(trabajadores[i].hilo, NULL);
+        ok = ok && trabajadores[i].ok;
+        ok = recursos_fusionar(recursos_mas_solicitados, trabajadores[i].recursos) && ok;
+        // Cada trabajador se creo como 'visitantes', asi que false aca es falta de memoria
+        // o un modo distinto; en los dos casos el conteo quedo incompleto y el comando falla.
+        ok = visitantes_fusionar(visitantes, trabajadores[i].visitantes) && ok;
+        recursos_destruir(trabajadores[i].recursos);
+        visitantes_destruir(trabajadores[i].visitantes);
+    }
+    free(trabajadores);
+    return ok;
+}
+
+bool procesar_logs(char** nombres_de_archivos, size_t cantidad, recursos_t* recursos_mas_solicitados, visitantes_t* visitantes) {
+
+    if (cantidad == 0) return false;
+    FILE** archivos = calloc(cantidad, sizeof(FILE*));
+    visitantes_t** DoS = calloc(cantidad, sizeof(visitantes_t*));
+    bool ok = archivos != NULL && DoS != NULL;
+
+    // Se abren todos antes de empezar, para no dejar una carga a medias si falta alguno.
+    for (size_t i = 0; ok && i < cantidad; i++) {
+        archivos[i] = fopen(nombres_de_archivos[i], "r");
+        DoS[i] = visitantes_crear();
+        ok = archivos[i] != NULL && DoS[i] != NULL;
+    }
+    if (ok) {
+        trabajo_logs_t trabajo = { .archivos = archivos, .DoS = DoS, .cantidad = cantidad, .proximo = 0 };
+        pthread_mutex_init(&trabajo.mutex, NULL);
+        ok = procesar_en_paralelo(&trabajo, recursos_mas_solicitados, visitantes);
+        pthread_mutex_destroy(&trabajo.mutex);
+    }
+    if (ok) {
+        salida_t salida;
+        salida_inicializar(&salida, STDOUT_FILENO);
+        for (size_t i = 0; i < cantidad; i++) {
+            visitantes_recorrer(DoS[i], imprimir_dos, &salida);
+        }
+        salida_volcar(&salida);
+    }
+
+    for (size_t i = 0; archivos != NULL && DoS != NULL && i < cantidad; i++) {
+        if (archivos[i] != NULL) fclose(archivos[i]);
+        visitantes_destruir(DoS[i]);
+    }
+    free(archivos);
+    free(DoS);
+    return ok;
+}
+
+bool procesar_log(char* nombre_de_archivo, recursos_t* recursos_mas_solicitados, visitantes_t* visitantes) {
+
+    return procesar_logs(&nombre_de_archivo, 1, recursos_mas_solicitados, visitantes);
+}
+
+/************************************ SEGUIMIENTO DE ARCHIVOS ************************************/
+
+struct archivo_seguido {
+    int descriptor;
+    dev_t dispositivo;
+    ino_t inodo;
+    off_t leidos;                   // Bytes del archivo ya pasados al buffer.
+    char* buffer;                   // Al principio queda la ultima linea incompleta.
+    size_t usados;
+    size_t capacidad;
+    procesamiento_t procesamiento;  // Las ventanas de DoS se mantienen entre lecturas.
+};
+
+//Procesa las lineas completas del buffer y deja al principio lo que sigue al ultimo salto.
+static void procesar_lineas_completas(archivo_seguido_t* seguido) {
+
+    size_t largo = seguido->usados;
+    while (largo > 0 && seguido->buffer[largo - 1] != '\n') largo--;
+    if (largo == 0) return;
+    procesar_bloque(&seguido->procesamiento, seguido->buffer, largo);
+    memmove(seguido->buffer, seguido->buffer + largo, seguido->usados - largo);
+    seguido->usados -= largo;
+}
+
+//Lee lo que se agrego al archivo desde la ultima lectura, procesa las lineas completas y
+//carga en 'DoS' las ips que resultaron sospechosas con ellas.
+static bool leer_agregado(archivo_seguido_t* seguido, recursos_t* recursos_mas_solicitados, visitantes_t* visitantes, visitantes_t* DoS) {
+
+    struct stat informacion;
+    if (fstat(seguido->descriptor, &informacion) == -1) return false;
+    if (informacion.st_size < seguido->leidos) {
+        // Se trunco (por ejemplo, al rotarlo): se vuelve a leer desde el principio.
+        seguido->leidos = 0;
+        seguido->usados = 0;
+    }
+    seguido->procesamiento.recursos_mas_solicitados = recursos_mas_solicitados;
+    seguido->procesamiento.visitantes = visitantes;
+    seguido->procesamiento.DoS = DoS;
+    while (true) {
+        if (seguido->usados == seguido->capacidad) {
+            // Una linea no entra en el buffer: se lo agranda.
+            char* buffer = realloc(seguido->buffer, seguido->capacidad * 2);
+            if (buffer == NULL) return false;
+            seguido->buffer = buffer;
+            seguido->capacidad *= 2;
+        }
+        ssize_t leidos = pread(seguido->descriptor, seguido->buffer + seguido->usados,
+                               seguido->capacidad - seguido->usados, seguido->leidos);
+        if (leidos < 0 && errno == EINTR) continue;
+        if (leidos < 0) return false;
+        if (leidos == 0) return true;
+        ESTADISTICAS_SUMAR(CONTADOR_BYTES_LEIDOS, (size_t)leidos);
+        seguido->leidos += leidos;
+        seguido->usados += (size_t)leidos;
+        procesar_lineas_completas(seguido);
+    }
+}
+
+//Lee lo nuevo del archivo e imprime, en orden, las ips que se detectaron como DoS con eso.
+static bool actualizar_e_imprimir(archivo_seguido_t* seguido, recursos_t* recursos_mas_solicitados, visitantes_t* visitantes) {
+
+    visitantes_t* DoS = visitantes_crear();
+    if (DoS == NULL) return false;
+    ESTADISTICAS_INICIO(inicio);
+    bool ok = leer_agregado(seguido, recursos_mas_solicitados, visitantes, DoS);
+    ESTADISTICAS_REGISTRAR(MEDICION_ARCHIVO, inicio);
+    if (visitantes_cantidad(DoS) > 0) {
+        salida_t salida;
+        salida_inicializar(&salida, STDOUT_FILENO);
+        visitantes_recorrer(DoS, imprimir_dos, &salida);
+        salida_volcar(&salida);
+    }
+    visitantes_destruir(DoS);
+    return ok;
+}
+
+archivo_seguido_t* seguir_archivo(const char* nombre_de_archivo, recursos_t* recursos_mas_solicitados, visitantes_t* visitantes) {
+
+    archivo_seguido_t* seguido = calloc(1, sizeof(archivo_seguido_t));
+    if (seguido == NULL) return NULL;
+    struct stat informacion;
+    seguido->descriptor = open(nombre_de_archivo, O_RDONLY);
+    seguido->capacidad = TAM_BUFFER_SEGUIMIENTO;
+    seguido->buffer = malloc(seguido->capacidad);
+    // Sin limite de memoria, para informar cada DoS apenas aparece en el archivo.
+    seguido->procesamiento.detector = detector_dos_crear(0);
+    if (seguido->descriptor == -1 || seguido->buffer == NULL || seguido->procesamiento.detector == NULL
+        || fstat(seguido->descriptor, &informacion) == -1 || !S_ISREG(informacion.st_mode)) {
+        dejar_de_seguir(seguido);
+        return NULL;
+    }
+    seguido->dispositivo = informacion.st_dev;
+    seguido->inodo = informacion.st_ino;
+    cache_fecha_inicializar(&seguido->procesamiento.cache_fecha);
+    if (!actualizar_e_imprimir(seguido, recursos_mas_solicitados, visitantes)) {
+        dejar_de_seguir(seguido);
+        return NULL;
+    }
+    return seguido;
+}
+
+bool actualizar_archivo_seguido(archivo_seguido_t* seguido, recursos_t* recursos_mas_solicitados, visitantes_t* visitantes) {
+
+    struct stat informacion;
+    if (fstat(seguido->descriptor, &informacion) == -1) return false;
+    // Lo comun es que no haya nada nuevo: se evita crear el conjunto de DoS.
+    if (informacion.st_size == seguido->leidos) return true;
+    return actualizar_e_imprimir(seguido, recursos_mas_solicitados, visitantes);
+}
+
+bool archivo_seguido_es(const archivo_seguido_t* seguido, const char* nombre_de_archivo) {
+
+    struct stat informacion;
+    return stat(nombre_de_archivo, &informacion) == 0
+        && informacion.st_dev == seguido->dispositivo && informacion.st_ino == seguido->inodo;
+}
+
+void dejar_de_seguir(archivo_seguido_t* seguido) {
+
+    if (seguido == NULL) return;
+    if (seguido->descriptor != -1) close(seguido->descriptor);
+    if (seguido->procesamiento.detector != NULL) detector_dos_destruir(seguido->procesamiento.detector);
+    buffer_campo_destruir(&seguido->procesamiento.recurso);
+    free(seguido->buffer);
+    free(seguido);
+}
+
+/************************************************************************************************/
+
+//Imprime una linea del listado de sitios mas visitados.
+static void imprimir_recurso(salida_t* salida, const char* recurso, int64_t solicitudes){
+
+    salida_caracter(salida, '\t');
+    salida_cadena(salida, recurso);
+    salida_cadena(salida, " - ");
+    salida_entero(salida, solicitudes);
+    salida_caracter(salida, '\n');
+}
+
+bool mostrar_mas_visitados(recursos_t* recursos_mas_solicitados, int cantidad_de_recursos_a_mostrar){
+
+    // No se pueden mostrar mas recursos que los guardados, asi que un n enorme no pide memoria de mas.
+    size_t k = cantidad_de_recursos_a_mostrar > 0 ? (size_t)cantidad_de_recursos_a_mostrar : 0;
+    if (k > hash_cantidad(recursos_mas_solicitados->hash)) k = hash_cantidad(recursos_mas_solicitados->hash);
+    recurso_t** mas_visitados = k > 0 ? malloc(sizeof(recurso_t*) * k) : NULL;
+    if (k > 0 && mas_visitados == NULL) return false;
     printf("Sitios más visitados:\n");
-    heap_t* recursos_temp = heap_crear((cmp_func_t)comparar_recursos);
-    if(!recursos_temp) return;
-    pasar_top_k_de_hash_a_heap(recursos_mas_solicitados, recursos_temp, cantidad_de_recursos_a_mostrar);
-    mostrar_n_recursos(recursos_temp, cantidad_de_recursos_a_mostrar);
-    heap_destruir(recursos_temp, NULL);
+    size_t cantidad = obtener_mas_solicitados(recursos_mas_solicitados, mas_visitados, k);
+    salida_t salida;
+    salida_inicializar(&salida, STDOUT_FILENO);
+    for (size_t i = 0; i < cantidad; i++) {
+        imprimir_recurso(&salida, mas_visitados[i]->clave, mas_visitados[i]->cant_de_solicitudes);
+    }
+    free(mas_visitados);
+    return salida_volcar(&salida);
+}
+
+//Lee el rango de ips de un comando: dos ips, o un bloque CIDR si 'ip_fin' es NULL.
+//Devuelve false si no es valido.
+static bool leer_rango_ips(const char* ip_inicio, const char* ip_fin, ip_t* inicio, ip_t* fin){
+
+    if (ip_fin == NULL) return ip_parsear_cidr(ip_inicio, strlen(ip_inicio), inicio, fin);
+    return ip_parsear(ip_inicio, strlen(ip_inicio), inicio) && ip_parsear(ip_fin, strlen(ip_fin), fin);
 }
 
-void mostrar_visitantes(abb_t* visitantes, char* ip_inicio, char* ip_fin){
+bool mostrar_visitantes(visitantes_t* visitantes, char* ip_inicio, char* ip_fin){
 
-    if(abb_cantidad(visitantes) == 0) return;
+    ip_t inicio, fin;
+    if (visitantes_es_aproximado(visitantes)) return false;
+    if (!leer_rango_ips(ip_inicio, ip_fin, &inicio, &fin)) return false;
+    if(visitantes_cantidad(visitantes) == 0) return true;
     fprintf(stdout, "Visitantes:\n");
-    recorrido_arbol(visitantes, imprimir_claves, NULL, ip_inicio, ip_fin);
+    salida_t salida;
+    salida_inicializar(&salida, STDOUT_FILENO);
+    visitantes_recorrer_rango(visitantes, inicio, fin, imprimir_visitante, &salida);
+    return salida_volcar(&salida);
+}
 
+bool mostrar_cantidad_visitantes(visitantes_t* visitantes, char* ip_inicio, char* ip_fin){
+
+    if (ip_inicio == NULL) {
+        fprintf(stdout, "Cantidad de visitantes: %zu\n", visitantes_cantidad(visitantes));
+        return true;
+    }
+    ip_t inicio, fin;
+    if (visitantes_es_aproximado(visitantes) || !leer_rango_ips(ip_inicio, ip_fin, &inicio, &fin)) return false;
+    fprintf(stdout, "Cantidad de visitantes: %zu\n", visitantes_contar_rango(visitantes, inicio, fin));
+    return true;
 }
 
+//Convierte las cadenas recibidas por el usuario en un intervalo de tiempo.
+//Devuelve false si alguna no es una fecha ISO-8601 valida.
+static bool leer_intervalo(const char* desde, const char* hasta, time_t* inicio, time_t* fin){
+
+    cache_fecha_t cache;
+    cache_fecha_inicializar(&cache);
+    return iso8601_a_tiempo(desde, strlen(desde), &cache, inicio) && iso8601_a_tiempo(hasta, strlen(hasta), &cache, fin);
+}
 
+bool mostrar_mas_visitados_entre(recursos_t* recursos_mas_solicitados, int n, char* desde, char* hasta){
 
+    time_t inicio, fin;
+    if (recursos_mas_solicitados->por_minuto == NULL || !leer_intervalo(desde, hasta, &inicio, &fin)) return false;
+    cuenta_recurso_t* cuentas;
+    size_t cantidad;
+    if (!indice_temporal_recursos_entre(recursos_mas_solicitados->por_minuto, inicio, fin, &cuentas, &cantidad)) return false;
+    fprintf(stdout, "Sitios más visitados:\n");
+    salida_t salida;
+    salida_inicializar(&salida, STDOUT_FILENO);
+    for (size_t i = 0; n > 0 && i < cantidad && i < (size_t)n; i++) {
+        imprimir_recurso(&salida, arena_cadenas_obtener(recursos_mas_solicitados->nombres, cuentas[i].id), cuentas[i].cantidad);
+    }
+    free(cuentas);
+    return salida_volcar(&salida);
+}
+
+bool mostrar_visitantes_entre(recursos_t* recursos_mas_solicitados, visitantes_t* visitantes, char* desde, char* hasta){
+
+    time_t inicio, fin;
+    if (recursos_mas_solicitados->por_minuto == NULL || !leer_intervalo(desde, hasta, &inicio, &fin)) return false;
+    ip_t* ips;
+    size_t cantidad;
+    if (!indice_temporal_visitantes_entre(recursos_mas_solicitados->por_minuto, inicio, fin, &ips, &cantidad)) return false;
+    // Como mostrar_visitantes, el encabezado sale siempre que haya visitantes cargados.
+    if (visitantes_cantidad(visitantes) > 0) fprintf(stdout, "Visitantes:\n");
+    salida_t salida;
+    salida_inicializar(&salida, STDOUT_FILENO);
+    for (size_t i = 0; i < cantidad; i++) {
+        imprimir_visitante(ips[i], &salida);
+    }
+    free(ips);
+    return salida_volcar(&salida);
+}
@@ -5,15 +5,58 @@
 #include <unistd.h>
 /************************************************************************************************/
 //Funcion que recibe un archivo y lo procesa, detectando posibles DoS y guardando ips y recursos donde corresponda.
-bool procesar_log(char* nombre_de_archivo, hash_t* recursos_mas_solicitados, abb_t* solicitantes);
+bool procesar_log(char* nombre_de_archivo, recursos_t* recursos_mas_solicitados, visitantes_t* visitantes);
+
+//Procesa varios archivos de log en paralelo, cada uno en un hilo con sus propias estructuras,
+//y fusiona los resultados. Las posibles DoS se detectan por archivo y se imprimen en el orden recibido.
+//Devuelve false, sin procesar nada, si alguno de los archivos no se puede abrir.
+bool procesar_logs(char** nombres_de_archivos, size_t cantidad, recursos_t* recursos_mas_solicitados, visitantes_t* visitantes);
+
+//Archivo de log que se sigue mientras crece. Recuerda hasta donde se leyo y las ventanas
+//de DoS de cada ip, asi cada actualizacion procesa solo las lineas completas nuevas.
+typedef struct archivo_seguido archivo_seguido_t;
+
+//Abre el archivo y procesa las lineas completas que ya tiene, imprimiendo las posibles DoS.
+//Devuelve NULL si no es un archivo regular o no se pudo abrir.
+archivo_seguido_t* seguir_archivo(const char* nombre_de_archivo, recursos_t* recursos_mas_solicitados, visitantes_t* visitantes);
+
+//Procesa las lineas completas agregadas al archivo desde la ultima actualizacion e imprime
+//las ips que se detectaron como DoS con ellas. Si el archivo se trunco, se lo vuelve a leer
+//desde el principio. Devuelve false si hubo un error de lectura.
+bool actualizar_archivo_seguido(archivo_seguido_t* seguido, recursos_t* recursos_mas_solicitados, visitantes_t* visitantes);
+
+//Devuelve true si el nombre corresponde al mismo archivo que se esta siguiendo.
+bool archivo_seguido_es(const archivo_seguido_t* seguido, const char* nombre_de_archivo);
+
+//Cierra el archivo y libera su estado.
+void dejar_de_seguir(archivo_seguido_t* seguido);
 
 //Obtiene los "N" sitios mas visitados de la pagina.
-void mostrar_mas_visitados(hash_t* recursos_mas_solicitados,  int n);
+//Devuelve false si no hubo memoria para armar la lista.
+bool mostrar_mas_visitados(recursos_t* recursos_mas_solicitados,  int n);
+
+//Recibe el conjunto de visitantes de la pagina y dos direcciones IP, o un bloque CIDR
+//(a.b.c.d/n) en 'ip_inicio' con 'ip_fin' en NULL.
+//Imprime por pantalla, en orden, los visitantes que pertenecen al rango.
+//Devuelve false si el rango no es valido o si los visitantes son aproximados.
+bool mostrar_visitantes(visitantes_t* visitantes, char* ip_inicio, char* ip_fin);
+
+//Como mostrar_mas_visitados, pero contando solo las solicitudes hechas entre las fechas
+//'desde' y 'hasta' (ISO-8601, con precision de minutos, ambos inclusive).
+//Devuelve false si alguna fecha no es valida o si se esta en modo aproximado.
+bool mostrar_mas_visitados_entre(recursos_t* recursos_mas_solicitados, int n, char* desde, char* hasta);
+
+//Imprime, en orden, los visitantes que hicieron alguna solicitud entre las fechas
+//'desde' y 'hasta' (ISO-8601, con precision de minutos, ambos inclusive). Como
+//mostrar_visitantes, imprime el encabezado si hay algun visitante cargado aunque el
+//intervalo quede vacio.
+//Devuelve false si alguna fecha no es valida o si se esta en modo aproximado.
+bool mostrar_visitantes_entre(recursos_t* recursos_mas_solicitados, visitantes_t* visitantes, char* desde, char* hasta);
 
-//Recibe el arbol que contiene a los visitantes de la pagina y dos direcciones IP.
-//Llama a una funcion que recorre el arbol y, a medida que va comparando si las
-//direcciones de los visitantes pertenecen al rango conformado entre las 2 ip's 
-//recibidas por parametro, va imprimiendolas por pantalla.
-void mostrar_visitantes(abb_t* visitantes, char* ip_inicio, char* ip_fin);
+//Imprime la cantidad de visitantes distintos de la pagina (estimada en modo aproximado).
+//Si 'ip_inicio' no es NULL, cuenta solo los del rango, dado como en mostrar_visitantes,
+//sin recorrerlos; eso requiere el modo exacto.
+//Devuelve false si el rango no es valido o si se pidio un rango en modo aproximado.
+bool mostrar_cantidad_visitantes(visitantes_t* visitantes, char* ip_inicio, char* ip_fin);
 
 #endif //ALGOS_GITHUB_COMANDOS_H
@@ -0,0 +1,110 @@
+#include <stdlib.h>
+#include <string.h>
+#include "count_min.h"
+
+#define NUMERO_E 2.718281828459045
+#define FNV_BASE 14695981039346656037ULL
+#define FNV_PRIMO 1099511628211ULL
+/***************************************************************************************/
+
+struct count_min {
+    uint32_t* contadores;
+    size_t ancho;
+    size_t profundidad;
+};
+
+//Hash FNV-1a de 64 bits. Las filas usan h1 + i * h2 con las dos mitades (Kirsch-Mitzenmacher).
+static uint64_t hash_clave(const char* clave) {
+
+    uint64_t hash = FNV_BASE;
+    for (const unsigned char* c = (const unsigned char*)clave; *c != '\0'; c++) {
+        hash = (hash ^ *c) * FNV_PRIMO;
+    }
+    return hash;
+}
+
+//Calcula la columna de la clave en cada fila.
+static void calcular_columnas(const count_min_t* sketch, const char* clave, size_t* columnas) {
+
+    uint64_t hash = hash_clave(clave);
+    uint32_t h1 = (uint32_t)hash;
+    uint32_t h2 = (uint32_t)(hash >> 32) | 1;
+    for (size_t i = 0; i < sketch->profundidad; i++) {
+        columnas[i] = i * sketch->ancho + (h1 + (uint32_t)i * h2) % sketch->ancho;
+    }
+}
+
+static count_min_t* crear_con_dimensiones(size_t ancho, size_t profundidad) {
+
+    count_min_t* sketch = malloc(sizeof(count_min_t));
+    if (sketch == NULL) return NULL;
+    sketch->contadores = calloc(ancho * profundidad, sizeof(uint32_t));
+    if (sketch->contadores == NULL) {
+        free(sketch);
+        return NULL;
+    }
+    sketch->ancho = ancho;
+    sketch->profundidad = profundidad;
+    return sketch;
+}
+
+count_min_t* count_min_crear(double error, double probabilidad_falla) {
+
+    if (error <= 0 || error >= 1 || probabilidad_falla <= 0 || probabilidad_falla >= 1) return NULL;
+    size_t ancho = (size_t)(NUMERO_E / error) + 1;
+    // Profundidad: menor d tal que e^-d <= probabilidad_falla.
+    size_t profundidad = 1;
+    for (double cota = 1 / NUMERO_E; cota > probabilidad_falla; cota /= NUMERO_E) profundidad++;
+    return crear_con_dimensiones(ancho, profundidad);
+}
+
+count_min_t* count_min_crear_como(const count_min_t* modelo) {
+
+    return crear_con_dimensiones(modelo->ancho, modelo->profundidad);
+}
+
+//Minimo de los contadores de la clave.
+static uint32_t minimo(const count_min_t* sketch, const size_t* columnas) {
+
+    uint32_t resultado = UINT32_MAX;
+    for (size_t i = 0; i < sketch->profundidad; i++) {
+        if (sketch->contadores[columnas[i]] < resultado) resultado = sketch->contadores[columnas[i]];
+    }
+    return resultado;
+}
+
+uint32_t count_min_sumar(count_min_t* sketch, const char* clave, uint32_t cantidad) {
+
+    size_t columnas[sketch->profundidad];
+    calcular_columnas(sketch, clave, columnas);
+    uint32_t actual = minimo(sketch, columnas);
+    uint32_t nuevo = actual > UINT32_MAX - cantidad ? UINT32_MAX : actual + cantidad;
+    // Actualizacion conservadora: solo se suben los contadores que quedarian por debajo.
+    for (size_t i = 0; i < sketch->profundidad; i++) {
+        if (sketch->contadores[columnas[i]] < nuevo) sketch->contadores[columnas[i]] = nuevo;
+    }
+    return nuevo;
+}
+
+uint32_t count_min_estimar(const count_min_t* sketch, const char* clave) {
+
+    size_t columnas[sketch->profundidad];
+    calcular_columnas(sketch, clave, columnas);
+    return minimo(sketch, columnas);
+}
+
+void count_min_fusionar(count_min_t* destino, const count_min_t* origen) {
+
+    size_t total = destino->ancho * destino->profundidad;
+    for (size_t i = 0; i < total; i++) {
+        uint32_t suma = destino->contadores[i] + origen->contadores[i];
+        destino->contadores[i] = suma < destino->contadores[i] ? UINT32_MAX : suma;
+    }
+}
+
+void count_min_destruir(count_min_t* sketch) {
+
+    if (sketch == NULL) return;
+    free(sketch->contadores);
+    free(sketch);
+}
@@ -0,0 +1,38 @@
+#ifndef ALGOS_GITHUB_COUNT_MIN_H
+#define ALGOS_GITHUB_COUNT_MIN_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+//Sketch Count-Min: estima la cantidad de apariciones de cada clave con memoria fija.
+//La estimacion nunca es menor al valor real y, con probabilidad 1 - probabilidad_falla,
+//no lo supera en mas de error * (total de apariciones).
+typedef struct count_min count_min_t;
+
+/*******************************************************************
+*                           PRIMITIVAS                             *
+*******************************************************************/
+
+//Crea un sketch vacio con las cotas de error pedidas (ambas entre 0 y 1).
+//Post: devuelve NULL si los parametros son invalidos o fallo la memoria.
+count_min_t* count_min_crear(double error, double probabilidad_falla);
+
+//Crea un sketch vacio con las mismas dimensiones que 'modelo', para poder fusionarlos.
+count_min_t* count_min_crear_como(const count_min_t* modelo);
+
+//Suma 'cantidad' apariciones de la clave (con actualizacion conservadora).
+//Post: devuelve la nueva estimacion de la clave.
+uint32_t count_min_sumar(count_min_t* sketch, const char* clave, uint32_t cantidad);
+
+//Devuelve la estimacion de apariciones de la clave.
+uint32_t count_min_estimar(const count_min_t* sketch, const char* clave);
+
+//Suma al sketch destino las apariciones del sketch origen.
+//Pre: ambos tienen las mismas dimensiones (ver count_min_crear_como).
+void count_min_fusionar(count_min_t* destino, const count_min_t* origen);
+
+//Destruye el sketch.
+void count_min_destruir(count_min_t* sketch);
+
+#endif //ALGOS_GITHUB_COUNT_MIN_H
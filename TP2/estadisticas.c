@@ -0,0 +1,125 @@
+#define _XOPEN_SOURCE 700
+
+#include <pthread.h>
+#include <time.h>
+#include "estadisticas.h"
+
+#ifdef SIN_ESTADISTICAS
+
+bool estadisticas_imprimir(FILE* salida) {
+
+    (void)salida;
+    return false;
+}
+
+#else
+
+//Cubeta i (i > 0) de un histograma: latencias en [2^(i-1), 2^i) microsegundos.
+//La cubeta 0 es para menos de 1 microsegundo y la ultima acumula todo lo que sobra.
+#define CANT_CUBETAS 32
+#define NANOSEGUNDOS_POR_MICROSEGUNDO 1000
+#define NANOSEGUNDOS_POR_MILISEGUNDO 1e6
+
+typedef struct histograma {
+    uint64_t cantidad;
+    uint64_t total_ns;
+    uint64_t maximo_ns;
+    uint64_t cubetas[CANT_CUBETAS];
+} histograma_t;
+
+static const char* NOMBRES_CONTADORES[CANT_CONTADORES] = {
+    [CONTADOR_LINEAS] = "lineas procesadas",
+    [CONTADOR_LINEAS_DESCARTADAS] = "lineas descartadas",
+    [CONTADOR_BYTES_LEIDOS] = "bytes leidos",
+    [CONTADOR_FECHAS_CONVERTIDAS] = "fechas convertidas",
+    [CONTADOR_FECHAS_INVALIDAS] = "fechas invalidas",
+    [CONTADOR_BUSQUEDAS_HASH] = "busquedas en hash",
+    [CONTADOR_REDIMENSIONES_HASH] = "redimensiones de hash",
+    [CONTADOR_VISITANTES_GUARDADOS] = "nodos de visitantes creados (incluye DoS)",
+    [CONTADOR_NODOS_CREADOS] = "nodos y claves creados (hash, listas, recursos, ventanas DoS, bloques de arena y visitantes)",
+};
+
+static const char* NOMBRES_MEDICIONES[CANT_MEDICIONES] = {
+    [MEDICION_ARCHIVO] = "carga de archivo",
+    [MEDICION_SPLIT] = "split de comando",
+    [MEDICION_AGREGAR_ARCHIVO] = "agregar_archivo",
+    [MEDICION_VER_MAS_VISITADOS] = "ver_mas_visitados",
+    [MEDICION_VER_VISITANTES] = "ver_visitantes",
+    [MEDICION_OTROS_COMANDOS] = "otros comandos",
+};
+
+__thread uint64_t estadisticas_del_hilo[CANT_CONTADORES];
+
+static uint64_t contadores[CANT_CONTADORES];
+static histograma_t histogramas[CANT_MEDICIONES];
+static pthread_mutex_t mutex_estadisticas = PTHREAD_MUTEX_INITIALIZER;
+
+uint64_t estadisticas_ahora(void) {
+
+    struct timespec ahora;
+    clock_gettime(CLOCK_MONOTONIC, &ahora);
+    return (uint64_t)ahora.tv_sec * 1000000000ULL + (uint64_t)ahora.tv_nsec;
+}
+
+static size_t cubeta_de(uint64_t nanosegundos) {
+
+    uint64_t microsegundos = nanosegundos / NANOSEGUNDOS_POR_MICROSEGUNDO;
+    size_t cubeta = 0;
+    while (microsegundos > 0 && cubeta < CANT_CUBETAS - 1) {
+        microsegundos >>= 1;
+        cubeta++;
+    }
+    return cubeta;
+}
+
+void estadisticas_registrar(medicion_t medicion, uint64_t inicio) {
+
+    uint64_t transcurrido = estadisticas_ahora() - inicio;
+    pthread_mutex_lock(&mutex_estadisticas);
+    histograma_t* histograma = &histogramas[medicion];
+    histograma->cantidad++;
+    histograma->total_ns += transcurrido;
+    if (transcurrido > histograma->maximo_ns) histograma->maximo_ns = transcurrido;
+    histograma->cubetas[cubeta_de(transcurrido)]++;
+    pthread_mutex_unlock(&mutex_estadisticas);
+}
+
+void estadisticas_volcar_hilo(void) {
+
+    pthread_mutex_lock(&mutex_estadisticas);
+    for (size_t i = 0; i < CANT_CONTADORES; i++) {
+        contadores[i] += estadisticas_del_hilo[i];
+        estadisticas_del_hilo[i] = 0;
+    }
+    pthread_mutex_unlock(&mutex_estadisticas);
+}
+
+static void imprimir_histograma(FILE* salida, const char* nombre, const histograma_t* histograma) {
+
+    if (histograma->cantidad == 0) return;
+    fprintf(salida, "\t%s: %llu, promedio %.3f ms, maximo %.3f ms\n", nombre, (unsigned long long)histograma->cantidad,
+            (double)histograma->total_ns / (double)histograma->cantidad / NANOSEGUNDOS_POR_MILISEGUNDO,
+            (double)histograma->maximo_ns / NANOSEGUNDOS_POR_MILISEGUNDO);
+    for (size_t i = 0; i < CANT_CUBETAS; i++) {
+        if (histograma->cubetas[i] == 0) continue;
+        if (i == 0) fprintf(salida, "\t\t< 1 us: %llu\n", (unsigned long long)histograma->cubetas[i]);
+        else fprintf(salida, "\t\t< %llu us: %llu\n", 1ULL << i, (unsigned long long)histograma->cubetas[i]);
+    }
+}
+
+bool estadisticas_imprimir(FILE* salida) {
+
+    estadisticas_volcar_hilo();
+    pthread_mutex_lock(&mutex_estadisticas);
+    fprintf(salida, "Estadisticas:\n");
+    for (size_t i = 0; i < CANT_CONTADORES; i++) {
+        fprintf(salida, "\t%s: %llu\n", NOMBRES_CONTADORES[i], (unsigned long long)contadores[i]);
+    }
+    for (size_t i = 0; i < CANT_MEDICIONES; i++) {
+        imprimir_histograma(salida, NOMBRES_MEDICIONES[i], &histogramas[i]);
+    }
+    pthread_mutex_unlock(&mutex_estadisticas);
+    return true;
+}
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef ALGOS_GITHUB_ESTADISTICAS_H
+#define ALGOS_GITHUB_ESTADISTICAS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/*
+ * Contadores y medicion de tiempos internos del programa, para el comando estadisticas.
+ * Los contadores se acumulan por hilo y se vuelcan a los globales al terminar cada
+ * trabajador (y antes de imprimir), asi el camino de cada linea no usa atomicos.
+ * Compilando con -DSIN_ESTADISTICAS las macros no generan codigo.
+ */
+
+typedef enum contador {
+    CONTADOR_LINEAS,
+    CONTADOR_LINEAS_DESCARTADAS,
+    CONTADOR_BYTES_LEIDOS,
+    CONTADOR_FECHAS_CONVERTIDAS,
+    CONTADOR_FECHAS_INVALIDAS,
+    CONTADOR_BUSQUEDAS_HASH,
+    CONTADOR_REDIMENSIONES_HASH,
+    CONTADOR_VISITANTES_GUARDADOS,
+    CONTADOR_NODOS_CREADOS,       // Solo nodos y copias de claves, no tablas ni buffers.
+    CANT_CONTADORES
+} contador_t;
+
+typedef enum medicion {
+    MEDICION_ARCHIVO,       // Carga de cada archivo de log.
+    MEDICION_SPLIT,         // Separacion de cada comando en palabras.
+    MEDICION_AGREGAR_ARCHIVO,
+    MEDICION_VER_MAS_VISITADOS,
+    MEDICION_VER_VISITANTES,
+    MEDICION_OTROS_COMANDOS,
+    CANT_MEDICIONES
+} medicion_t;
+
+#ifdef SIN_ESTADISTICAS
+
+#define ESTADISTICAS_SUMAR(contador, cantidad) ((void)0)
+#define ESTADISTICAS_INICIO(variable)
+#define ESTADISTICAS_REGISTRAR(medicion, variable) ((void)0)
+#define ESTADISTICAS_VOLCAR_HILO() ((void)0)
+
+#else
+
+#define ESTADISTICAS_SUMAR(contador, cantidad) (estadisticas_del_hilo[contador] += (uint64_t)(cantidad))
+#define ESTADISTICAS_INICIO(variable) uint64_t variable = estadisticas_ahora()
+#define ESTADISTICAS_REGISTRAR(medicion, variable) estadisticas_registrar((medicion), (variable))
+#define ESTADISTICAS_VOLCAR_HILO() estadisticas_volcar_hilo()
+
+//Contadores del hilo actual que todavia no se volcaron a los globales.
+extern __thread uint64_t estadisticas_del_hilo[CANT_CONTADORES];
+
+//Devuelve el instante actual en nanosegundos (reloj monotono).
+uint64_t estadisticas_ahora(void);
+
+//Agrega al histograma de la medicion el tiempo transcurrido desde 'inicio'.
+void estadisticas_registrar(medicion_t medicion, uint64_t inicio);
+
+//Suma los contadores del hilo actual a los globales y los pone en cero.
+void estadisticas_volcar_hilo(void);
+
+#endif
+
+//Imprime los contadores y, para cada medicion, la cantidad, el promedio, el maximo y
+//el histograma de latencias.
+//Post: devuelve false si el programa se compilo sin estadisticas.
+bool estadisticas_imprimir(FILE* salida);
+
+#endif //ALGOS_GITHUB_ESTADISTICAS_H
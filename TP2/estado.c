@@ -0,0 +1,174 @@
+#define _XOPEN_SOURCE 700
+
+#include <fcntl.h>
+#include <limits.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "estado.h"
+
+#define MAGIA_ESTADO "TP2E"
+#define LARGO_MAGIA 4
+#define VERSION_ESTADO 2
+#define MARCA_ORDEN_BYTES 0x01020304
+#define SUFIJO_TEMPORAL ".tmp"
+#define IPS_POR_TANDA 1024
+/***********************************************************************************************/
+
+typedef struct cabecera_estado {
+    char magia[LARGO_MAGIA];
+    uint32_t version;
+    uint32_t orden_bytes;
+    uint32_t reservado;
+    uint64_t cant_visitantes;
+    uint64_t cant_recursos;
+} cabecera_estado_t;
+
+//Estado de la escritura de visitantes, para cortar el recorrido si falla fwrite.
+typedef struct escritura {
+    FILE* archivo;
+    bool ok;
+} escritura_t;
+
+static bool escribir_visitante(ip_t ip, void* extra) {
+
+    escritura_t* escritura = extra;
+    uint8_t bytes[TAM_IP_BINARIA];
+    ip_codificar(ip, bytes);
+    escritura->ok = fwrite(bytes, TAM_IP_BINARIA, 1, escritura->archivo) == 1;
+    return escritura->ok;
+}
+
+static bool escribir_recursos(FILE* archivo, recursos_t* recursos_mas_solicitados) {
+
+    hash_iter_t* iter = hash_iter_crear(recursos_mas_solicitados->hash);
+    if (iter == NULL) return false;
+    bool ok = true;
+    while (ok && !hash_iter_al_final(iter)) {
+        const char* clave = hash_iter_ver_actual(iter);
+        recurso_t* recurso = hash_obtener(recursos_mas_solicitados->hash, clave);
+        int64_t solicitudes = recurso->cant_de_solicitudes;
+        uint32_t largo = (uint32_t)strlen(clave);
+        ok = fwrite(&solicitudes, sizeof(int64_t), 1, archivo) == 1
+            && fwrite(&largo, sizeof(uint32_t), 1, archivo) == 1
+            && fwrite(clave, 1, largo, archivo) == largo;
+        hash_iter_avanzar(iter);
+    }
+    hash_iter_destruir(iter);
+    return ok;
+}
+
+bool guardar_estado(const char* nombre_de_archivo, recursos_t* recursos_mas_solicitados, visitantes_t* visitantes) {
+
+    // Los sketches del modo aproximado no tienen formato de estado.
+    if (recursos_es_aproximado(recursos_mas_solicitados) || visitantes_es_aproximado(visitantes)) return false;
+    size_t largo_nombre = strlen(nombre_de_archivo);
+    char* nombre_temporal = malloc(largo_nombre + sizeof(SUFIJO_TEMPORAL));
+    if (nombre_temporal == NULL) return false;
+    memcpy(nombre_temporal, nombre_de_archivo, largo_nombre);
+    memcpy(nombre_temporal + largo_nombre, SUFIJO_TEMPORAL, sizeof(SUFIJO_TEMPORAL));
+
+    FILE* archivo = fopen(nombre_temporal, "wb");
+    if (archivo == NULL) {
+        free(nombre_temporal);
+        return false;
+    }
+    cabecera_estado_t cabecera = {
+        .magia = MAGIA_ESTADO,
+        .version = VERSION_ESTADO,
+        .orden_bytes = MARCA_ORDEN_BYTES,
+        .cant_visitantes = visitantes_cantidad(visitantes),
+        .cant_recursos = hash_cantidad(recursos_mas_solicitados->hash),
+    };
+    escritura_t escritura = { .archivo = archivo, .ok = true };
+    bool ok = fwrite(&cabecera, sizeof(cabecera_estado_t), 1, archivo) == 1;
+    if (ok) {
+        visitantes_recorrer(visitantes, escribir_visitante, &escritura);
+        ok = escritura.ok && escribir_recursos(archivo, recursos_mas_solicitados);
+    }
+    ok = fclose(archivo) == 0 && ok;
+    ok = ok && rename(nombre_temporal, nombre_de_archivo) == 0;
+    if (!ok) remove(nombre_temporal);
+    free(nombre_temporal);
+    return ok;
+}
+
+//Recorre la seccion de recursos verificando que no se pase del final del archivo y que
+//cada cantidad de solicitudes entre en un int sin ser negativa.
+//Si 'recursos_mas_solicitados' es NULL solo valida; si no, suma las solicitudes.
+static bool leer_recursos(const char* datos, size_t largo, uint64_t cantidad, recursos_t* recursos_mas_solicitados) {
+
+    size_t pos = 0;
+    buffer_campo_t clave = { 0 };
+    bool ok = true;
+    for (uint64_t i = 0; ok && i < cantidad; i++) {
+        int64_t solicitudes;
+        uint32_t largo_clave;
+        if (largo - pos < sizeof(int64_t) + sizeof(uint32_t)) {
+            ok = false;
+            break;
+        }
+        memcpy(&solicitudes, datos + pos, sizeof(int64_t));
+        memcpy(&largo_clave, datos + pos + sizeof(int64_t), sizeof(uint32_t));
+        pos += sizeof(int64_t) + sizeof(uint32_t);
+        if (solicitudes < 0 || solicitudes > INT_MAX || largo - pos < largo_clave) {
+            ok = false;
+            break;
+        }
+        if (recursos_mas_solicitados != NULL) {
+            campo_t campo = { .inicio = datos + pos, .largo = largo_clave };
+            const char* nombre = campo_a_cadena(campo, &clave);
+            ok = nombre != NULL && sumar_solicitudes_recurso(recursos_mas_solicitados, nombre, (int)solicitudes);
+        }
+        pos += largo_clave;
+    }
+    buffer_campo_destruir(&clave);
+    return ok && pos == largo;
+}
+
+//Decodifica las ips guardadas de a tandas y las agrega al conjunto, que las recibe ordenadas.
+static bool cargar_visitantes(visitantes_t* visitantes, const uint8_t* bytes, size_t cantidad) {
+
+    ip_t tanda[IPS_POR_TANDA];
+    for (size_t i = 0; i < cantidad; i += IPS_POR_TANDA) {
+        size_t en_tanda = cantidad - i < IPS_POR_TANDA ? cantidad - i : IPS_POR_TANDA;
+        for (size_t j = 0; j < en_tanda; j++) tanda[j] = ip_decodificar(bytes + (i + j) * TAM_IP_BINARIA);
+        if (!visitantes_guardar_ordenadas(visitantes, tanda, en_tanda)) return false;
+    }
+    return true;
+}
+
+bool cargar_estado(const char* nombre_de_archivo, recursos_t* recursos_mas_solicitados, visitantes_t* visitantes) {
+
+    if (recursos_es_aproximado(recursos_mas_solicitados) || visitantes_es_aproximado(visitantes)) return false;
+    int descriptor = open(nombre_de_archivo, O_RDONLY);
+    if (descriptor == -1) return false;
+    struct stat informacion;
+    if (fstat(descriptor, &informacion) == -1 || (size_t)informacion.st_size < sizeof(cabecera_estado_t)) {
+        close(descriptor);
+        return false;
+    }
+    size_t largo = (size_t)informacion.st_size;
+    const char* datos = mmap(NULL, largo, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    close(descriptor);
+    if (datos == MAP_FAILED) return false;
+
+    cabecera_estado_t cabecera;
+    memcpy(&cabecera, datos, sizeof(cabecera_estado_t));
+    size_t resto = largo - sizeof(cabecera_estado_t);
+    bool ok = memcmp(cabecera.magia, MAGIA_ESTADO, LARGO_MAGIA) == 0 && cabecera.version == VERSION_ESTADO
+        && cabecera.orden_bytes == MARCA_ORDEN_BYTES && cabecera.cant_visitantes <= resto / TAM_IP_BINARIA;
+
+    if (ok) {
+        const uint8_t* ips = (const uint8_t*)(datos + sizeof(cabecera_estado_t));
+        size_t bytes_visitantes = (size_t)cabecera.cant_visitantes * TAM_IP_BINARIA;
+        const char* seccion_recursos = datos + sizeof(cabecera_estado_t) + bytes_visitantes;
+        size_t largo_recursos = resto - bytes_visitantes;
+        ok = leer_recursos(seccion_recursos, largo_recursos, cabecera.cant_recursos, NULL)
+            && cargar_visitantes(visitantes, ips, (size_t)cabecera.cant_visitantes)
+            && leer_recursos(seccion_recursos, largo_recursos, cabecera.cant_recursos, recursos_mas_solicitados);
+    }
+    munmap((void*)datos, largo);
+    return ok;
+}
@@ -0,0 +1,26 @@
+#ifndef ALGOS_GITHUB_ESTADO_H
+#define ALGOS_GITHUB_ESTADO_H
+
+#include "tp2.h"
+
+/*
+ * Formato del archivo de estado (enteros en el orden de bytes de la maquina):
+ *
+ *   cabecera_estado_t
+ *   uint8_t visitantes[cant_visitantes][16]     en orden creciente, codificadas con ip_codificar
+ *   por cada recurso: int64_t solicitudes, uint32_t largo, char clave[largo]
+ *
+ * Al cargarlo se proyecta en memoria y se reconstruyen las estructuras sin parsear texto.
+ */
+/************************************************************************************************/
+
+//Guarda en el archivo los recursos con su cantidad de solicitudes y el conjunto de visitantes.
+//Devuelve false si no se pudo escribir o si se esta en modo aproximado. El archivo se reemplaza solo si se escribio completo.
+bool guardar_estado(const char* nombre_de_archivo, recursos_t* recursos_mas_solicitados, visitantes_t* visitantes);
+
+//Suma al estado actual el estado guardado en el archivo.
+//Devuelve false, sin modificar nada, si el archivo no existe, no es un estado valido
+//o si se esta en modo aproximado.
+bool cargar_estado(const char* nombre_de_archivo, recursos_t* recursos_mas_solicitados, visitantes_t* visitantes);
+
+#endif //ALGOS_GITHUB_ESTADO_H
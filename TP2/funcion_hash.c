@@ -0,0 +1,77 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "funcion_hash.h"
+
+#define DISPOSITIVO_ALEATORIO "/dev/urandom"
+#define BYTES_POR_PALABRA 8
+#define RONDAS_FINALES 3
+
+// Constantes iniciales de SipHash ("somepseudorandomlygeneratedbytes").
+#define SIP_V0 0x736f6d6570736575ULL
+#define SIP_V1 0x646f72616e646f6dULL
+#define SIP_V2 0x6c7967656e657261ULL
+#define SIP_V3 0x7465646279746573ULL
+
+#define ROTAR(x, b) (uint64_t)(((x) << (b)) | ((x) >> (64 - (b))))
+
+// Una ronda de SipHash sobre el estado v0..v3. Es una macro para que quede en linea
+// tambien compilando sin optimizaciones.
+#define SIP_RONDA(v0, v1, v2, v3) do { \
+    v0 += v1; v1 = ROTAR(v1, 13); v1 ^= v0; v0 = ROTAR(v0, 32); \
+    v2 += v3; v3 = ROTAR(v3, 16); v3 ^= v2; \
+    v0 += v3; v3 = ROTAR(v3, 21); v3 ^= v0; \
+    v2 += v1; v1 = ROTAR(v1, 17); v1 ^= v2; v2 = ROTAR(v2, 32); \
+} while (0)
+
+// Mezcla los bits de un valor como el finalizador de splitmix64.
+static uint64_t mezclar(uint64_t valor) {
+
+    valor += 0x9e3779b97f4a7c15ULL;
+    valor = (valor ^ (valor >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    valor = (valor ^ (valor >> 27)) * 0x94d049bb133111ebULL;
+    return valor ^ (valor >> 31);
+}
+
+void semilla_hash_aleatoria(semilla_hash_t* semilla) {
+
+    FILE* aleatorio = fopen(DISPOSITIVO_ALEATORIO, "rb");
+    bool leida = aleatorio != NULL && fread(semilla, sizeof(semilla_hash_t), 1, aleatorio) == 1;
+    if (aleatorio != NULL) fclose(aleatorio);
+    if (leida) return;
+    // Con ASLR las direcciones tampoco las conoce quien escribe los logs.
+    struct timespec ahora;
+    clock_gettime(CLOCK_REALTIME, &ahora);
+    semilla->k0 = mezclar((uint64_t)ahora.tv_sec ^ (uint64_t)(uintptr_t)semilla);
+    semilla->k1 = mezclar((uint64_t)ahora.tv_nsec ^ (uint64_t)(uintptr_t)&ahora);
+}
+
+size_t funcion_hash(const char* clave, const semilla_hash_t* semilla) {
+
+    size_t largo = strlen(clave);
+    uint64_t v0 = semilla->k0 ^ SIP_V0;
+    uint64_t v1 = semilla->k1 ^ SIP_V1;
+    uint64_t v2 = semilla->k0 ^ SIP_V2;
+    uint64_t v3 = semilla->k1 ^ SIP_V3;
+    const unsigned char* actual = (const unsigned char*)clave;
+    const unsigned char* fin = actual + (largo - largo % BYTES_POR_PALABRA);
+    for (; actual != fin; actual += BYTES_POR_PALABRA) {
+        uint64_t palabra;
+        memcpy(&palabra, actual, BYTES_POR_PALABRA);
+        v3 ^= palabra;
+        SIP_RONDA(v0, v1, v2, v3);
+        v0 ^= palabra;
+    }
+    // La ultima palabra lleva los bytes que sobran y el largo en el byte mas alto.
+    uint64_t ultima = (uint64_t)largo << 56;
+    for (size_t i = 0; i < largo % BYTES_POR_PALABRA; i++) ultima |= (uint64_t)actual[i] << (8 * i);
+    v3 ^= ultima;
+    SIP_RONDA(v0, v1, v2, v3);
+    v0 ^= ultima;
+    v2 ^= 0xff;
+    for (int i = 0; i < RONDAS_FINALES; i++) SIP_RONDA(v0, v1, v2, v3);
+    return (size_t)(v0 ^ v1 ^ v2 ^ v3);
+}
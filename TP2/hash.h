@@ -14,10 +14,25 @@ typedef struct hash_iter hash_iter_t;
 // tipo de función para destruir dato
 typedef void (*hash_destruir_dato_t)(void *);
 
+// tipo de función para crear el dato de una clave nueva en hash_obtener_o_insertar.
+// Recibe la clave y el 'extra' que se le paso; devuelve NULL si no pudo crearlo.
+typedef void *(*hash_crear_dato_t)(const char *clave, void *extra);
+
+// tipo de función para crear el dato de una clave nueva en hash_obtener_o_insertar_con_clave.
+// Ademas del dato, deja en *guardada la cadena que el hash usa como clave: una igual a
+// 'clave' que siga valida mientras este en el hash (por ejemplo, una que es parte del dato).
+typedef void *(*hash_crear_dato_y_clave_t)(const char *clave, const char **guardada, void *extra);
+
 /* Crea el hash
  */
 hash_t *hash_crear(hash_destruir_dato_t destruir_dato);
 
+/* Crea un hash que no copia las claves: guarda los punteros recibidos en
+ * hash_guardar y no los libera.
+ * Pre: cada clave guardada sigue valida y sin cambios mientras este en el hash.
+ */
+hash_t *hash_crear_sin_copiar_claves(hash_destruir_dato_t destruir_dato);
+
 /* Guarda un elemento en el hash, si la clave ya se encuentra en la
  * estructura, la reemplaza. De no poder guardarlo devuelve false.
  * Pre: La estructura hash fue inicializada
@@ -25,6 +40,23 @@ hash_t *hash_crear(hash_destruir_dato_t destruir_dato);
  */
 bool hash_guardar(hash_t *hash, const char *clave, void *dato);
 
+/* Busca la clave una sola vez y devuelve la direccion donde el hash guarda su
+ * dato, para leerlo o cambiarlo sin volver a buscarla. Si la clave no estaba, la
+ * guarda con el dato que devuelve crear_dato(clave, extra).
+ * Devuelve NULL si la clave no estaba y no se pudo crear el dato o guardarla.
+ * Pre: La estructura hash fue inicializada
+ * Post: La direccion sirve hasta la proxima vez que se guarde o borre en el hash.
+ */
+void **hash_obtener_o_insertar(hash_t *hash, const char *clave, hash_crear_dato_t crear_dato, void *extra);
+
+/* Igual que hash_obtener_o_insertar, para hashes creados con hash_crear_sin_copiar_claves:
+ * si la clave no estaba, se guarda con la cadena que crear_dato(clave, &guardada, extra)
+ * deja en 'guardada' en lugar de 'clave', que puede ser temporal.
+ * Pre: La estructura hash fue inicializada
+ * Post: La direccion sirve hasta la proxima vez que se guarde o borre en el hash.
+ */
+void **hash_obtener_o_insertar_con_clave(hash_t *hash, const char *clave, hash_crear_dato_y_clave_t crear_dato, void *extra);
+
 /* Borra un elemento del hash y devuelve el dato asociado.  Devuelve
  * NULL si el dato no estaba.
  * Pre: La estructura hash fue inicializada
@@ -0,0 +1,303 @@
+#define _POSIX_C_SOURCE 200809L
+#include "hash.h"
+#include "funcion_hash.h"
+
+//Implementacion alternativa de hash.h con direccionamiento abierto y Robin Hood.
+//Se compila en lugar de hash.c con -DHASH_ROBIN_HOOD (make HASH_ROBIN_HOOD=1).
+#ifdef HASH_ROBIN_HOOD
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include "estadisticas.h"
+
+#define TAMANIO_INICIAL 64      // Potencia de dos, para calcular la posicion con una mascara.
+//Se agranda al superar 7/8 de ocupacion y se achica por debajo de 1/8.
+#define MAX_CARGA_NUMERADOR 7
+#define MAX_CARGA_DENOMINADOR 8
+#define MIN_CARGA_DENOMINADOR 8
+#define FACTOR_REDIM 2
+
+
+/*******************************************************************
+ *                DEFINICION DE LOS TIPOS DE DATOS                 *
+ ******************************************************************/
+
+//Las entradas se guardan en la misma tabla, asi que una busqueda recorre posiciones
+//contiguas en lugar de seguir punteros. Una entrada libre tiene la clave en NULL.
+typedef struct hash_entrada {
+    size_t hash;    //Resultado completo de funcion_hash, para no recalcularlo al redimensionar.
+    char *clave;
+    void *dato;
+} hash_entrada_t;
+
+struct hash {
+    hash_entrada_t *tabla;
+    size_t tamanio;
+    size_t cantidad;
+    hash_destruir_dato_t destruir_dato;
+    semilla_hash_t semilla;     //Clave de funcion_hash, elegida al azar en hash_crear.
+    bool copia_claves;  //Si es false, las claves son de quien las guardo.
+};
+
+struct hash_iter {
+    const hash_t *hash;
+    size_t pos_actual;
+};
+
+/*******************************************************************
+*                        FUNCIONES PRIVADAS                        *
+*******************************************************************/
+//Devuelve cuantas posiciones quedo la entrada de 'pos' despues de la que le corresponde.
+static size_t distancia(const hash_t *hash, size_t pos) {
+
+    return (pos - (hash->tabla[pos].hash & (hash->tamanio - 1))) & (hash->tamanio - 1);
+}
+
+//Pre: Hash fue creado
+//Post: Devuelve true si la clave esta, dejando su posicion en 'pos'. Si no esta, deja en
+//'pos' y 'recorrido' donde habria que ubicarla: como las entradas quedan ordenadas por
+//distancia, la busqueda termina en una posicion libre o en una entrada mas cerca de su
+//lugar que lo recorrido, que es la que le cederia el lugar.
+static bool buscar_posicion(const hash_t *hash, const char *clave, size_t valor_hash, size_t *pos, size_t *recorrido) {
+
+    ESTADISTICAS_SUMAR(CONTADOR_BUSQUEDAS_HASH, 1);
+    size_t mascara = hash->tamanio - 1;
+    *pos = valor_hash & mascara;
+    for (*recorrido = 0; hash->tabla[*pos].clave != NULL && distancia(hash, *pos) >= *recorrido; (*recorrido)++) {
+        if (hash->tabla[*pos].hash == valor_hash && strcmp(hash->tabla[*pos].clave, clave) == 0) return true;
+        *pos = (*pos + 1) & mascara;
+    }
+    return false;
+}
+
+//Ubica una entrada que no esta en la tabla a partir de 'pos', habiendo ya recorrido
+//'recorrido' posiciones desde su lugar. Cuando la entrada que se esta ubicando recorrio mas
+//que la que ocupa la posicion, le quita el lugar y se sigue con la desplazada; asi la
+//entrada recibida siempre queda en 'pos'.
+//Pre: la tabla tiene al menos una posicion libre.
+static void ubicar_entrada(hash_entrada_t *tabla, size_t tamanio, hash_entrada_t entrada, size_t pos, size_t recorrido) {
+
+    size_t mascara = tamanio - 1;
+    while (tabla[pos].clave != NULL) {
+        size_t distancia_actual = (pos - (tabla[pos].hash & mascara)) & mascara;
+        if (distancia_actual < recorrido) {
+            hash_entrada_t desplazada = tabla[pos];
+            tabla[pos] = entrada;
+            entrada = desplazada;
+            recorrido = distancia_actual;
+        }
+        pos = (pos + 1) & mascara;
+        recorrido++;
+    }
+    tabla[pos] = entrada;
+}
+
+//Pre: Recibe un hash y un tamaño potencia de dos que alcanza para sus elementos
+//Post: La tabla correspondiente al hash recibido por parametro fue redimensionada a el tamaño recibido por parametro
+static bool hash_redimensionar(hash_t *hash, size_t nuevo_tamanio) {
+
+    ESTADISTICAS_SUMAR(CONTADOR_REDIMENSIONES_HASH, 1);
+    hash_entrada_t *tabla_nueva = calloc(nuevo_tamanio, sizeof(hash_entrada_t));
+    if (tabla_nueva == NULL) return false;
+    for (size_t i = 0; i < hash->tamanio; i++) {
+        if (hash->tabla[i].clave == NULL) continue;
+        ubicar_entrada(tabla_nueva, nuevo_tamanio, hash->tabla[i], hash->tabla[i].hash & (nuevo_tamanio - 1), 0);
+    }
+    free(hash->tabla);
+    hash->tabla = tabla_nueva;
+    hash->tamanio = nuevo_tamanio;
+    return true;
+}
+
+//Saltea las posiciones libres a partir de la actual.
+static void encontrar_proxima_entrada(hash_iter_t *iter) {
+
+    while (iter->pos_actual < iter->hash->tamanio && iter->hash->tabla[iter->pos_actual].clave == NULL) {
+        iter->pos_actual++;
+    }
+}
+
+
+/*******************************************************************
+*                        IMPLEMENTACION HASH                       *
+*******************************************************************/
+
+hash_t *hash_crear(hash_destruir_dato_t destruir_dato) {
+
+    hash_t *hash = malloc(sizeof(hash_t));
+    if (hash == NULL) return NULL;
+    hash->tabla = calloc(TAMANIO_INICIAL, sizeof(hash_entrada_t));
+    if (hash->tabla == NULL) {
+        free(hash);
+        return NULL;
+    }
+    hash->tamanio = TAMANIO_INICIAL;
+    hash->cantidad = 0;
+    hash->destruir_dato = destruir_dato;
+    semilla_hash_aleatoria(&hash->semilla);
+    hash->copia_claves = true;
+    return hash;
+}
+
+hash_t *hash_crear_sin_copiar_claves(hash_destruir_dato_t destruir_dato) {
+
+    hash_t *hash = hash_crear(destruir_dato);
+    if (hash == NULL) return NULL;
+    hash->copia_claves = false;
+    return hash;
+}
+
+//Agranda la tabla si una entrada mas la dejaria demasiado llena. Se hace antes de buscar,
+//para que la posicion que deja la busqueda sirva para insertar.
+static bool asegurar_lugar(hash_t *hash) {
+
+    if ((hash->cantidad + 1) * MAX_CARGA_DENOMINADOR <= hash->tamanio * MAX_CARGA_NUMERADOR) return true;
+    return hash_redimensionar(hash, hash->tamanio * FACTOR_REDIM);
+}
+
+//Inserta en 'pos' una clave que no esta, copiandola si corresponde.
+static bool insertar_en(hash_t *hash, const char *clave, size_t valor_hash, void *dato, size_t pos, size_t recorrido) {
+
+    char *copia = hash->copia_claves ? strdup(clave) : (char*)clave;
+    if (copia == NULL) return false;
+    ESTADISTICAS_SUMAR(CONTADOR_NODOS_CREADOS, hash->copia_claves ? 1 : 0);
+    hash_entrada_t entrada = { .hash = valor_hash, .clave = copia, .dato = dato };
+    ubicar_entrada(hash->tabla, hash->tamanio, entrada, pos, recorrido);
+    hash->cantidad++;
+    return true;
+}
+
+bool hash_guardar(hash_t *hash, const char *clave, void *dato) {
+
+    if (!asegurar_lugar(hash)) return false;
+    size_t valor_hash = funcion_hash(clave, &hash->semilla);
+    size_t pos, recorrido;
+    if (!buscar_posicion(hash, clave, valor_hash, &pos, &recorrido)) {
+        return insertar_en(hash, clave, valor_hash, dato, pos, recorrido);
+    }
+    if (hash->destruir_dato != NULL) hash->destruir_dato(hash->tabla[pos].dato);
+    hash->tabla[pos].dato = dato;
+    return true;
+}
+
+//Si la clave no esta, crea el dato con crear_dato o, si es NULL, con crear_dato_y_clave,
+//que tambien elige la clave que se guarda.
+static void **obtener_o_insertar(hash_t *hash, const char *clave, hash_crear_dato_t crear_dato,
+                                 hash_crear_dato_y_clave_t crear_dato_y_clave, void *extra) {
+
+    if (!asegurar_lugar(hash)) return NULL;
+    size_t valor_hash = funcion_hash(clave, &hash->semilla);
+    size_t pos, recorrido;
+    if (buscar_posicion(hash, clave, valor_hash, &pos, &recorrido)) return &hash->tabla[pos].dato;
+    const char *guardada = clave;
+    void *dato = crear_dato != NULL ? crear_dato(clave, extra) : crear_dato_y_clave(clave, &guardada, extra);
+    if (dato == NULL) return NULL;
+    if (!insertar_en(hash, guardada, valor_hash, dato, pos, recorrido)) {
+        if (hash->destruir_dato != NULL) hash->destruir_dato(dato);
+        return NULL;
+    }
+    return &hash->tabla[pos].dato;
+}
+
+void **hash_obtener_o_insertar(hash_t *hash, const char *clave, hash_crear_dato_t crear_dato, void *extra) {
+
+    return obtener_o_insertar(hash, clave, crear_dato, NULL, extra);
+}
+
+void **hash_obtener_o_insertar_con_clave(hash_t *hash, const char *clave, hash_crear_dato_y_clave_t crear_dato, void *extra) {
+
+    return obtener_o_insertar(hash, clave, NULL, crear_dato, extra);
+}
+
+//Al borrar, las entradas que siguen se corren un lugar hacia atras hasta una libre o una
+//que ya esta en su lugar, asi no hacen falta marcas de borrado.
+void *hash_borrar(hash_t *hash, const char *clave) {
+
+    size_t pos, recorrido;
+    if (!buscar_posicion(hash, clave, funcion_hash(clave, &hash->semilla), &pos, &recorrido)) return NULL;
+    void *dato = hash->tabla[pos].dato;
+    if (hash->copia_claves) free(hash->tabla[pos].clave);
+    size_t mascara = hash->tamanio - 1;
+    size_t siguiente = (pos + 1) & mascara;
+    while (hash->tabla[siguiente].clave != NULL && distancia(hash, siguiente) > 0) {
+        hash->tabla[pos] = hash->tabla[siguiente];
+        pos = siguiente;
+        siguiente = (siguiente + 1) & mascara;
+    }
+    hash->tabla[pos].clave = NULL;
+    hash->cantidad--;
+    // Si no se puede achicar, el hash sigue siendo valido con la tabla actual.
+    if (hash->tamanio > TAMANIO_INICIAL && hash->cantidad * MIN_CARGA_DENOMINADOR < hash->tamanio) {
+        hash_redimensionar(hash, hash->tamanio / FACTOR_REDIM);
+    }
+    return dato;
+}
+
+bool hash_pertenece(const hash_t *hash, const char *clave) {
+
+    size_t pos, recorrido;
+    return buscar_posicion(hash, clave, funcion_hash(clave, &hash->semilla), &pos, &recorrido);
+}
+
+void *hash_obtener(const hash_t *hash, const char *clave) {
+
+    size_t pos, recorrido;
+    return buscar_posicion(hash, clave, funcion_hash(clave, &hash->semilla), &pos, &recorrido) ? hash->tabla[pos].dato : NULL;
+}
+
+size_t hash_cantidad(const hash_t *hash) {
+
+    return hash->cantidad;
+}
+
+void hash_destruir(hash_t *hash) {
+
+    for (size_t i = 0; i < hash->tamanio; i++) {
+        if (hash->tabla[i].clave == NULL) continue;
+        if (hash->destruir_dato != NULL) hash->destruir_dato(hash->tabla[i].dato);
+        if (hash->copia_claves) free(hash->tabla[i].clave);
+    }
+    free(hash->tabla);
+    free(hash);
+}
+
+/*******************************************************************
+ *                    PRIMITIVAS DEL ITERADOR                      *
+ ******************************************************************/
+
+hash_iter_t *hash_iter_crear(const hash_t *hash) {
+
+    hash_iter_t *iter = malloc(sizeof(hash_iter_t));
+    if (!iter) return NULL;
+    iter->hash = hash;
+    iter->pos_actual = 0;
+    encontrar_proxima_entrada(iter);
+    return iter;
+}
+
+bool hash_iter_al_final(const hash_iter_t *iter) {
+
+    return iter->pos_actual == iter->hash->tamanio;
+}
+
+bool hash_iter_avanzar(hash_iter_t *iter) {
+
+    if (hash_iter_al_final(iter)) return false;
+    iter->pos_actual++;
+    encontrar_proxima_entrada(iter);
+    return true;
+}
+
+const char *hash_iter_ver_actual(const hash_iter_t *iter) {
+
+    if (hash_iter_al_final(iter)) return NULL;
+    return iter->hash->tabla[iter->pos_actual].clave;
+}
+
+void hash_iter_destruir(hash_iter_t *iter) {
+
+    free(iter);
+}
+
+#endif //HASH_ROBIN_HOOD
@@ -0,0 +1,95 @@
+#include <math.h>
+#include <stdlib.h>
+#include "hyperloglog.h"
+
+#define BITS_HASH 64
+#define ERROR_POR_REGISTRO 1.04
+/***************************************************************************************/
+
+struct hll {
+    uint8_t* registros;
+    size_t cantidad_registros;
+    uint8_t precision;
+};
+
+uint8_t hll_precision_para_error(double error) {
+
+    uint8_t precision = HLL_PRECISION_MINIMA;
+    while (precision < HLL_PRECISION_MAXIMA && ERROR_POR_REGISTRO / sqrt((double)(1UL << precision)) > error) {
+        precision++;
+    }
+    return precision;
+}
+
+hll_t* hll_crear(uint8_t precision) {
+
+    if (precision < HLL_PRECISION_MINIMA || precision > HLL_PRECISION_MAXIMA) return NULL;
+    hll_t* hll = malloc(sizeof(hll_t));
+    if (hll == NULL) return NULL;
+    hll->cantidad_registros = (size_t)1 << precision;
+    hll->registros = calloc(hll->cantidad_registros, sizeof(uint8_t));
+    if (hll->registros == NULL) {
+        free(hll);
+        return NULL;
+    }
+    hll->precision = precision;
+    return hll;
+}
+
+hll_t* hll_crear_como(const hll_t* modelo) {
+
+    return hll_crear(modelo->precision);
+}
+
+void hll_agregar(hll_t* hll, uint64_t hash) {
+
+    // Los primeros bits eligen el registro; el resto aporta la posicion del primer 1.
+    size_t indice = (size_t)(hash >> (BITS_HASH - hll->precision));
+    uint64_t resto = hash << hll->precision;
+    uint8_t rango = 1;
+    while (rango <= BITS_HASH - hll->precision && (resto & (1ULL << (BITS_HASH - 1))) == 0) {
+        rango++;
+        resto <<= 1;
+    }
+    if (rango > hll->registros[indice]) hll->registros[indice] = rango;
+}
+
+//Constante de correccion del sesgo segun la cantidad de registros.
+static double alfa(size_t cantidad_registros) {
+
+    if (cantidad_registros == 16) return 0.673;
+    if (cantidad_registros == 32) return 0.697;
+    if (cantidad_registros == 64) return 0.709;
+    return 0.7213 / (1 + 1.079 / (double)cantidad_registros);
+}
+
+size_t hll_estimar(const hll_t* hll) {
+
+    double m = (double)hll->cantidad_registros;
+    double suma = 0;
+    size_t registros_en_cero = 0;
+    for (size_t i = 0; i < hll->cantidad_registros; i++) {
+        suma += ldexp(1.0, -hll->registros[i]);
+        if (hll->registros[i] == 0) registros_en_cero++;
+    }
+    double estimacion = alfa(hll->cantidad_registros) * m * m / suma;
+    // Para cardinalidades chicas se usa conteo lineal, que es mas preciso.
+    if (estimacion <= 2.5 * m && registros_en_cero > 0) {
+        estimacion = m * log(m / (double)registros_en_cero);
+    }
+    return (size_t)(estimacion + 0.5);
+}
+
+void hll_fusionar(hll_t* destino, const hll_t* origen) {
+
+    for (size_t i = 0; i < destino->cantidad_registros; i++) {
+        if (origen->registros[i] > destino->registros[i]) destino->registros[i] = origen->registros[i];
+    }
+}
+
+void hll_destruir(hll_t* hll) {
+
+    if (hll == NULL) return;
+    free(hll->registros);
+    free(hll);
+}
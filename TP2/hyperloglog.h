@@ -0,0 +1,42 @@
+#ifndef ALGOS_GITHUB_HYPERLOGLOG_H
+#define ALGOS_GITHUB_HYPERLOGLOG_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+//Estimador HyperLogLog de la cantidad de elementos distintos, con memoria fija de
+//2^precision bytes y error relativo tipico de 1.04 / sqrt(2^precision).
+typedef struct hll hll_t;
+
+#define HLL_PRECISION_MINIMA 4
+#define HLL_PRECISION_MAXIMA 18
+
+/*******************************************************************
+*                           PRIMITIVAS                             *
+*******************************************************************/
+
+//Devuelve la menor precision cuyo error relativo tipico no supera 'error'.
+uint8_t hll_precision_para_error(double error);
+
+//Crea un estimador vacio.
+//Pre: HLL_PRECISION_MINIMA <= precision <= HLL_PRECISION_MAXIMA.
+//Post: devuelve NULL si la precision es invalida o fallo la memoria.
+hll_t* hll_crear(uint8_t precision);
+
+//Crea un estimador vacio con la misma precision que 'modelo', para poder fusionarlos.
+hll_t* hll_crear_como(const hll_t* modelo);
+
+//Agrega un elemento, dado por un hash de 64 bits bien distribuido.
+void hll_agregar(hll_t* hll, uint64_t hash);
+
+//Devuelve la estimacion de la cantidad de elementos distintos agregados.
+size_t hll_estimar(const hll_t* hll);
+
+//Agrega al estimador destino los elementos del estimador origen.
+//Pre: ambos tienen la misma precision.
+void hll_fusionar(hll_t* destino, const hll_t* origen);
+
+//Destruye el estimador.
+void hll_destruir(hll_t* hll);
+
+#endif //ALGOS_GITHUB_HYPERLOGLOG_H
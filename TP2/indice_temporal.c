@@ -0,0 +1,288 @@
+#include <stdlib.h>
+#include <string.h>
+#include "indice_temporal.h"
+
+#define CAPACIDAD_INICIAL 16
+//Cantidad de entradas sin ordenar que se toleran en un minuto antes de compactarlo.
+#define MINIMO_PARA_COMPACTAR 64
+
+/*******************************************************************
+ *                DEFINICION DE LOS TIPOS DE DATOS                 *
+ ******************************************************************/
+
+//Solicitudes de un minuto. Los primeros 'cuentas_compactas' elementos de 'cuentas' estan
+//ordenados por id y sin repetidos, e igual los primeros 'visitantes_compactos' de
+//'visitantes'; el resto se agrego despues y se ordena al compactar.
+typedef struct minuto {
+    int64_t numero;     // Minutos desde la epoca.
+    cuenta_recurso_t* cuentas;
+    size_t cant_cuentas;
+    size_t cap_cuentas;
+    size_t cuentas_compactas;
+    ip_t* visitantes;
+    size_t cant_visitantes;
+    size_t cap_visitantes;
+    size_t visitantes_compactos;
+} minuto_t;
+
+//Minutos ordenados por numero. Los logs suelen venir en orden, asi que casi siempre se
+//agrega al final o se vuelve al ultimo minuto usado.
+struct indice_temporal {
+    minuto_t* minutos;
+    size_t cantidad;
+    size_t capacidad;
+    size_t ultimo;
+};
+
+/*******************************************************************
+*                        FUNCIONES PRIVADAS                        *
+*******************************************************************/
+
+//Agranda el arreglo (al doble) si no tiene lugar para 'necesaria' elementos.
+static bool asegurar_capacidad(void** datos, size_t* capacidad, size_t necesaria, size_t tam_elemento) {
+
+    if (necesaria <= *capacidad) return true;
+    size_t nueva_capacidad = *capacidad > 0 ? *capacidad : CAPACIDAD_INICIAL;
+    while (nueva_capacidad < necesaria) nueva_capacidad *= 2;
+    void* nuevos = realloc(*datos, nueva_capacidad * tam_elemento);
+    if (nuevos == NULL) return false;
+    *datos = nuevos;
+    *capacidad = nueva_capacidad;
+    return true;
+}
+
+//Devuelve el minuto (desde la epoca) al que pertenece el instante, redondeando hacia abajo.
+static int64_t numero_de_minuto(time_t instante) {
+
+    int64_t segundos = (int64_t)instante;
+    int64_t numero = segundos / SEGUNDOS_POR_MINUTO;
+    return segundos % SEGUNDOS_POR_MINUTO < 0 ? numero - 1 : numero;
+}
+
+//Devuelve la posicion del primer minuto con numero mayor o igual al dado.
+static size_t primer_minuto_desde(const indice_temporal_t* indice, int64_t numero) {
+
+    size_t inicio = 0;
+    size_t fin = indice->cantidad;
+    while (inicio < fin) {
+        size_t medio = inicio + (fin - inicio) / 2;
+        if (indice->minutos[medio].numero < numero) inicio = medio + 1;
+        else fin = medio;
+    }
+    return inicio;
+}
+
+//Devuelve el minuto con ese numero, creandolo vacio si no existia. NULL si fallo la memoria.
+static minuto_t* obtener_minuto(indice_temporal_t* indice, int64_t numero) {
+
+    if (indice->ultimo < indice->cantidad && indice->minutos[indice->ultimo].numero == numero) {
+        return &indice->minutos[indice->ultimo];
+    }
+    size_t posicion = primer_minuto_desde(indice, numero);
+    if (posicion == indice->cantidad || indice->minutos[posicion].numero != numero) {
+        if (!asegurar_capacidad((void**)&indice->minutos, &indice->capacidad, indice->cantidad + 1, sizeof(minuto_t))) return NULL;
+        memmove(&indice->minutos[posicion + 1], &indice->minutos[posicion], (indice->cantidad - posicion) * sizeof(minuto_t));
+        memset(&indice->minutos[posicion], 0, sizeof(minuto_t));
+        indice->minutos[posicion].numero = numero;
+        indice->cantidad++;
+    }
+    indice->ultimo = posicion;
+    return &indice->minutos[posicion];
+}
+
+static int comparar_cuentas_por_id(const void* a, const void* b) {
+
+    uint32_t id_a = ((const cuenta_recurso_t*)a)->id;
+    uint32_t id_b = ((const cuenta_recurso_t*)b)->id;
+    return (id_a > id_b) - (id_a < id_b);
+}
+
+//De mas a menos solicitudes; a igual cantidad, primero el recurso que aparecio antes.
+static int comparar_cuentas_por_cantidad(const void* a, const void* b) {
+
+    const cuenta_recurso_t* cuenta_a = a;
+    const cuenta_recurso_t* cuenta_b = b;
+    if (cuenta_a->cantidad != cuenta_b->cantidad) return cuenta_a->cantidad < cuenta_b->cantidad ? 1 : -1;
+    return comparar_cuentas_por_id(a, b);
+}
+
+static int comparar_ips(const void* a, const void* b) {
+
+    ip_t ip_a = *(const ip_t*)a;
+    ip_t ip_b = *(const ip_t*)b;
+    return (ip_a > ip_b) - (ip_a < ip_b);
+}
+
+//Ordena las cuentas por id y suma las del mismo recurso. Devuelve la nueva cantidad.
+static size_t compactar_cuentas(cuenta_recurso_t* cuentas, size_t cantidad) {
+
+    if (cantidad == 0) return 0;
+    qsort(cuentas, cantidad, sizeof(cuenta_recurso_t), comparar_cuentas_por_id);
+    size_t distintas = 1;
+    for (size_t i = 1; i < cantidad; i++) {
+        if (cuentas[i].id == cuentas[distintas - 1].id) cuentas[distintas - 1].cantidad += cuentas[i].cantidad;
+        else cuentas[distintas++] = cuentas[i];
+    }
+    return distintas;
+}
+
+//Ordena las ips y quita las repetidas. Devuelve la nueva cantidad.
+static size_t compactar_ips(ip_t* ips, size_t cantidad) {
+
+    if (cantidad == 0) return 0;
+    qsort(ips, cantidad, sizeof(ip_t), comparar_ips);
+    size_t distintas = 1;
+    for (size_t i = 1; i < cantidad; i++) {
+        if (ips[i] != ips[distintas - 1]) ips[distintas++] = ips[i];
+    }
+    return distintas;
+}
+
+static void compactar_minuto(minuto_t* minuto) {
+
+    if (minuto->cant_cuentas > minuto->cuentas_compactas) {
+        minuto->cant_cuentas = compactar_cuentas(minuto->cuentas, minuto->cant_cuentas);
+        minuto->cuentas_compactas = minuto->cant_cuentas;
+    }
+    if (minuto->cant_visitantes > minuto->visitantes_compactos) {
+        minuto->cant_visitantes = compactar_ips(minuto->visitantes, minuto->cant_visitantes);
+        minuto->visitantes_compactos = minuto->cant_visitantes;
+    }
+}
+
+//Compacta el minuto si las entradas agregadas desde la ultima vez ya ocupan mas que las compactas.
+static void compactar_si_hace_falta(minuto_t* minuto) {
+
+    if (minuto->cant_cuentas >= 2 * minuto->cuentas_compactas + MINIMO_PARA_COMPACTAR
+        || minuto->cant_visitantes >= 2 * minuto->visitantes_compactos + MINIMO_PARA_COMPACTAR) {
+        compactar_minuto(minuto);
+    }
+}
+
+//Suma solicitudes de un recurso al minuto. Las solicitudes seguidas al mismo recurso se acumulan juntas.
+static bool sumar_cuenta(minuto_t* minuto, uint32_t id_recurso, uint32_t cantidad) {
+
+    if (minuto->cant_cuentas > minuto->cuentas_compactas && minuto->cuentas[minuto->cant_cuentas - 1].id == id_recurso) {
+        minuto->cuentas[minuto->cant_cuentas - 1].cantidad += cantidad;
+        return true;
+    }
+    if (!asegurar_capacidad((void**)&minuto->cuentas, &minuto->cap_cuentas, minuto->cant_cuentas + 1, sizeof(cuenta_recurso_t))) return false;
+    minuto->cuentas[minuto->cant_cuentas].id = id_recurso;
+    minuto->cuentas[minuto->cant_cuentas].cantidad = cantidad;
+    minuto->cant_cuentas++;
+    return true;
+}
+
+//Agrega la ip a los visitantes del minuto, salvo que sea la misma que la ultima agregada.
+static bool agregar_visitante(minuto_t* minuto, ip_t ip) {
+
+    if (minuto->cant_visitantes > 0 && minuto->visitantes[minuto->cant_visitantes - 1] == ip) return true;
+    if (!asegurar_capacidad((void**)&minuto->visitantes, &minuto->cap_visitantes, minuto->cant_visitantes + 1, sizeof(ip_t))) return false;
+    minuto->visitantes[minuto->cant_visitantes++] = ip;
+    return true;
+}
+
+//Devuelve en 'inicio' y 'fin' las posiciones de los minutos del intervalo [desde, hasta].
+static void minutos_entre(const indice_temporal_t* indice, time_t desde, time_t hasta, size_t* inicio, size_t* fin) {
+
+    *inicio = primer_minuto_desde(indice, numero_de_minuto(desde));
+    *fin = primer_minuto_desde(indice, numero_de_minuto(hasta) + 1);
+    if (*fin < *inicio) *fin = *inicio;
+}
+
+/*******************************************************************
+*                           PRIMITIVAS                             *
+*******************************************************************/
+
+indice_temporal_t* indice_temporal_crear(void) {
+
+    indice_temporal_t* indice = malloc(sizeof(indice_temporal_t));
+    if (indice == NULL) return NULL;
+    indice->minutos = NULL;
+    indice->cantidad = 0;
+    indice->capacidad = 0;
+    indice->ultimo = 0;
+    return indice;
+}
+
+bool indice_temporal_registrar(indice_temporal_t* indice, time_t instante, uint32_t id_recurso, ip_t ip) {
+
+    minuto_t* minuto = obtener_minuto(indice, numero_de_minuto(instante));
+    if (minuto == NULL || !sumar_cuenta(minuto, id_recurso, 1) || !agregar_visitante(minuto, ip)) return false;
+    compactar_si_hace_falta(minuto);
+    return true;
+}
+
+bool indice_temporal_fusionar(indice_temporal_t* destino, const indice_temporal_t* origen, const uint32_t* ids_en_destino) {
+
+    for (size_t i = 0; i < origen->cantidad; i++) {
+        const minuto_t* minuto_origen = &origen->minutos[i];
+        minuto_t* minuto = obtener_minuto(destino, minuto_origen->numero);
+        if (minuto == NULL) return false;
+        for (size_t j = 0; j < minuto_origen->cant_cuentas; j++) {
+            const cuenta_recurso_t* cuenta = &minuto_origen->cuentas[j];
+            if (!sumar_cuenta(minuto, ids_en_destino[cuenta->id], cuenta->cantidad)) return false;
+        }
+        for (size_t j = 0; j < minuto_origen->cant_visitantes; j++) {
+            if (!agregar_visitante(minuto, minuto_origen->visitantes[j])) return false;
+        }
+        compactar_minuto(minuto);
+    }
+    return true;
+}
+
+bool indice_temporal_recursos_entre(indice_temporal_t* indice, time_t desde, time_t hasta,
+                                    cuenta_recurso_t** cuentas, size_t* cantidad) {
+
+    size_t inicio, fin;
+    minutos_entre(indice, desde, hasta, &inicio, &fin);
+    size_t total = 0;
+    for (size_t i = inicio; i < fin; i++) {
+        compactar_minuto(&indice->minutos[i]);
+        total += indice->minutos[i].cant_cuentas;
+    }
+    cuenta_recurso_t* todas = malloc(sizeof(cuenta_recurso_t) * (total > 0 ? total : 1));
+    if (todas == NULL) return false;
+    size_t copiadas = 0;
+    for (size_t i = inicio; i < fin; i++) {
+        memcpy(todas + copiadas, indice->minutos[i].cuentas, sizeof(cuenta_recurso_t) * indice->minutos[i].cant_cuentas);
+        copiadas += indice->minutos[i].cant_cuentas;
+    }
+    *cantidad = compactar_cuentas(todas, total);
+    qsort(todas, *cantidad, sizeof(cuenta_recurso_t), comparar_cuentas_por_cantidad);
+    *cuentas = todas;
+    return true;
+}
+
+bool indice_temporal_visitantes_entre(indice_temporal_t* indice, time_t desde, time_t hasta,
+                                      ip_t** ips, size_t* cantidad) {
+
+    size_t inicio, fin;
+    minutos_entre(indice, desde, hasta, &inicio, &fin);
+    size_t total = 0;
+    for (size_t i = inicio; i < fin; i++) {
+        compactar_minuto(&indice->minutos[i]);
+        total += indice->minutos[i].cant_visitantes;
+    }
+    ip_t* todas = malloc(sizeof(ip_t) * (total > 0 ? total : 1));
+    if (todas == NULL) return false;
+    size_t copiadas = 0;
+    for (size_t i = inicio; i < fin; i++) {
+        memcpy(todas + copiadas, indice->minutos[i].visitantes, sizeof(ip_t) * indice->minutos[i].cant_visitantes);
+        copiadas += indice->minutos[i].cant_visitantes;
+    }
+    *cantidad = compactar_ips(todas, total);
+    *ips = todas;
+    return true;
+}
+
+void indice_temporal_destruir(indice_temporal_t* indice) {
+
+    if (indice == NULL) return;
+    for (size_t i = 0; i < indice->cantidad; i++) {
+        free(indice->minutos[i].cuentas);
+        free(indice->minutos[i].visitantes);
+    }
+    free(indice->minutos);
+    free(indice);
+}
@@ -0,0 +1,55 @@
+#ifndef ALGOS_GITHUB_INDICE_TEMPORAL_H
+#define ALGOS_GITHUB_INDICE_TEMPORAL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <time.h>
+#include "ip.h"
+
+#define SEGUNDOS_POR_MINUTO 60
+
+//Cantidad de solicitudes de un recurso, identificado por su id en la arena de recursos.
+typedef struct cuenta_recurso {
+    uint32_t id;
+    uint32_t cantidad;
+} cuenta_recurso_t;
+
+//Indice de las solicitudes por minuto: para cada minuto con solicitudes guarda cuantas
+//tuvo cada recurso y que ips lo visitaron, de forma que se pueda responder sobre un
+//intervalo de tiempo sin volver a leer los logs.
+typedef struct indice_temporal indice_temporal_t;
+
+/*******************************************************************
+*                           PRIMITIVAS                             *
+*******************************************************************/
+
+//Crea un indice vacio.
+//Post: devuelve NULL si fallo la memoria.
+indice_temporal_t* indice_temporal_crear(void);
+
+//Registra una solicitud de la ip al recurso con ese id, en el minuto del instante dado.
+//Post: devuelve false si fallo la memoria.
+bool indice_temporal_registrar(indice_temporal_t* indice, time_t instante, uint32_t id_recurso, ip_t ip);
+
+//Agrega al indice destino todas las solicitudes del indice origen. 'ids_en_destino'
+//traduce cada id de recurso de origen al id del mismo recurso en destino.
+//Post: devuelve false si fallo la memoria.
+bool indice_temporal_fusionar(indice_temporal_t* destino, const indice_temporal_t* origen, const uint32_t* ids_en_destino);
+
+//Calcula cuantas solicitudes tuvo cada recurso en los minutos que van del de 'desde' al
+//de 'hasta', inclusive. Deja en 'cuentas' un arreglo nuevo (a liberar con free), ordenado
+//de mas a menos solicitado, y en 'cantidad' su largo.
+//Post: devuelve false si fallo la memoria.
+bool indice_temporal_recursos_entre(indice_temporal_t* indice, time_t desde, time_t hasta,
+                                    cuenta_recurso_t** cuentas, size_t* cantidad);
+
+//Igual que indice_temporal_recursos_entre, pero deja en 'ips' las ips distintas que
+//hicieron alguna solicitud en el intervalo, ordenadas de menor a mayor.
+bool indice_temporal_visitantes_entre(indice_temporal_t* indice, time_t desde, time_t hasta,
+                                      ip_t** ips, size_t* cantidad);
+
+//Destruye el indice.
+void indice_temporal_destruir(indice_temporal_t* indice);
+
+#endif //ALGOS_GITHUB_INDICE_TEMPORAL_H
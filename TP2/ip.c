@@ -0,0 +1,221 @@
+#include <string.h>
+#include "ip.h"
+
+#define CANT_OCTETOS 4
+#define MAX_DIGITOS_OCTETO 3
+#define MAX_VALOR_OCTETO 255
+#define BITS_POR_OCTETO 8
+#define BITS_IPV4 32
+#define CANT_GRUPOS 8
+#define MAX_DIGITOS_GRUPO 4
+#define BITS_POR_GRUPO 16
+#define MAX_DIGITOS_PREFIJO 3
+#define PREFIJO_IPV4_MAPEADA ((ip_t)0xFFFF << BITS_IPV4)
+/***************************************************************************************/
+
+//Convierte una IPv4 en formato a.b.c.d a un entero de 32 bits.
+static bool parsear_v4(const char* cadena, size_t largo, uint32_t* ip) {
+
+    uint32_t resultado = 0;
+    size_t pos = 0;
+    for (int octeto = 0; octeto < CANT_OCTETOS; octeto++) {
+        if (octeto > 0) {
+            if (pos >= largo || cadena[pos] != '.') return false;
+            pos++;
+        }
+        unsigned valor = 0;
+        size_t digitos = 0;
+        while (pos < largo && cadena[pos] >= '0' && cadena[pos] <= '9' && digitos < MAX_DIGITOS_OCTETO) {
+            valor = valor * 10 + (unsigned)(cadena[pos] - '0');
+            pos++;
+            digitos++;
+        }
+        if (digitos == 0 || valor > MAX_VALOR_OCTETO) return false;
+        resultado = (resultado << BITS_POR_OCTETO) | valor;
+    }
+    if (pos != largo) return false;
+    *ip = resultado;
+    return true;
+}
+
+//Devuelve el valor del digito hexadecimal, o -1 si el caracter no lo es.
+static int valor_hexadecimal(char caracter) {
+
+    if (caracter >= '0' && caracter <= '9') return caracter - '0';
+    if (caracter >= 'a' && caracter <= 'f') return caracter - 'a' + 10;
+    if (caracter >= 'A' && caracter <= 'F') return caracter - 'A' + 10;
+    return -1;
+}
+
+//Convierte una IPv6 en texto. Los grupos se leen de izquierda a derecha y, si hubo un '::',
+//los que le siguen se corren al final completando con ceros.
+static bool parsear_v6(const char* cadena, size_t largo, ip_t* ip) {
+
+    uint16_t grupos[CANT_GRUPOS];
+    size_t cantidad = 0;
+    size_t compresion = CANT_GRUPOS + 1;    // Cantidad de grupos antes del '::'; sin '::' queda fuera de rango.
+    size_t pos = 0;
+    if (largo >= 2 && cadena[0] == ':' && cadena[1] == ':') {
+        compresion = 0;
+        pos = 2;
+    }
+    while (pos < largo) {
+        if (cantidad == CANT_GRUPOS) return false;
+        size_t inicio = pos;
+        unsigned valor = 0;
+        size_t digitos = 0;
+        int digito;
+        while (pos < largo && digitos < MAX_DIGITOS_GRUPO && (digito = valor_hexadecimal(cadena[pos])) >= 0) {
+            valor = (valor << 4) | (unsigned)digito;
+            pos++;
+            digitos++;
+        }
+        if (pos < largo && cadena[pos] == '.') {
+            // Una IPv4 al final ocupa los dos ultimos grupos.
+            uint32_t v4;
+            if (cantidad + 2 > CANT_GRUPOS || !parsear_v4(cadena + inicio, largo - inicio, &v4)) return false;
+            grupos[cantidad++] = (uint16_t)(v4 >> BITS_POR_GRUPO);
+            grupos[cantidad++] = (uint16_t)v4;
+            break;
+        }
+        if (digitos == 0) return false;
+        grupos[cantidad++] = (uint16_t)valor;
+        if (pos == largo) break;
+        if (cadena[pos] != ':' || ++pos == largo) return false;
+        if (cadena[pos] == ':') {
+            if (compresion <= CANT_GRUPOS) return false;
+            compresion = cantidad;
+            pos++;
+        }
+    }
+    if (compresion > CANT_GRUPOS ? cantidad != CANT_GRUPOS : cantidad == CANT_GRUPOS) return false;
+
+    ip_t resultado = 0;
+    size_t leidos = 0;
+    for (size_t i = 0; i < CANT_GRUPOS; i++) {
+        bool es_cero = i >= compresion && i < compresion + CANT_GRUPOS - cantidad;
+        resultado = (resultado << BITS_POR_GRUPO) | (es_cero ? 0 : grupos[leidos++]);
+    }
+    *ip = resultado;
+    return true;
+}
+
+bool ip_parsear(const char* cadena, size_t largo, ip_t* ip) {
+
+    // Las IPv4, que son la mayoria, fallan rapido en parsear_v6, asi que van primero.
+    uint32_t v4;
+    if (parsear_v4(cadena, largo, &v4)) {
+        *ip = PREFIJO_IPV4_MAPEADA | v4;
+        return true;
+    }
+    return parsear_v6(cadena, largo, ip);
+}
+
+bool ip_parsear_cidr(const char* cadena, size_t largo, ip_t* inicio, ip_t* fin) {
+
+    const char* barra = memchr(cadena, '/', largo);
+    if (barra == NULL) return false;
+    size_t largo_ip = (size_t)(barra - cadena);
+    uint32_t v4;
+    ip_t ip;
+    bool es_v4 = parsear_v4(cadena, largo_ip, &v4);
+    if (es_v4) ip = PREFIJO_IPV4_MAPEADA | v4;
+    else if (!parsear_v6(cadena, largo_ip, &ip)) return false;
+
+    const char* actual = barra + 1;
+    size_t digitos = largo - (size_t)(actual - cadena);
+    if (digitos == 0 || digitos > MAX_DIGITOS_PREFIJO) return false;
+    unsigned prefijo = 0;
+    for (size_t i = 0; i < digitos; i++) {
+        if (actual[i] < '0' || actual[i] > '9') return false;
+        prefijo = prefijo * 10 + (unsigned)(actual[i] - '0');
+    }
+    if (prefijo > (es_v4 ? BITS_IPV4 : BITS_IP)) return false;
+    if (es_v4) prefijo += BITS_IP - BITS_IPV4;
+
+    ip_t mascara = prefijo == 0 ? 0 : IP_MAXIMA << (BITS_IP - prefijo);
+    *inicio = ip & mascara;
+    *fin = *inicio | ~mascara;
+    return true;
+}
+
+bool ip_es_v4(ip_t ip) {
+
+    return (ip >> BITS_IPV4) == (PREFIJO_IPV4_MAPEADA >> BITS_IPV4);
+}
+
+//Escribe la IPv4 con puntos, sin '\0'. Devuelve el final de lo escrito.
+static char* escribir_v4(uint32_t ip, char* actual) {
+
+    for (int desplazamiento = BITS_IPV4 - BITS_POR_OCTETO; desplazamiento >= 0; desplazamiento -= BITS_POR_OCTETO) {
+        unsigned octeto = (ip >> desplazamiento) & 0xFF;
+        if (octeto >= 100) *actual++ = (char)('0' + octeto / 100);
+        if (octeto >= 10) *actual++ = (char)('0' + octeto / 10 % 10);
+        *actual++ = (char)('0' + octeto % 10);
+        if (desplazamiento > 0) *actual++ = '.';
+    }
+    return actual;
+}
+
+//Escribe la IPv6 en forma canonica, sin '\0': hexadecimal en minuscula sin ceros a la
+//izquierda, y la racha mas larga de dos o mas grupos en cero (la primera si empatan) como '::'.
+static char* escribir_v6(ip_t ip, char* actual) {
+
+    const char* digitos = "0123456789abcdef";
+    unsigned grupos[CANT_GRUPOS];
+    for (size_t i = 0; i < CANT_GRUPOS; i++) {
+        grupos[i] = (unsigned)(ip >> (BITS_POR_GRUPO * (CANT_GRUPOS - 1 - i))) & 0xFFFF;
+    }
+    size_t inicio_ceros = CANT_GRUPOS, largo_ceros = 1;
+    for (size_t i = 0; i < CANT_GRUPOS; ) {
+        size_t j = i;
+        while (j < CANT_GRUPOS && grupos[j] == 0) j++;
+        if (j - i > largo_ceros) {
+            inicio_ceros = i;
+            largo_ceros = j - i;
+        }
+        i = j == i ? i + 1 : j;
+    }
+
+    for (size_t i = 0; i < CANT_GRUPOS; i++) {
+        if (i == inicio_ceros) {
+            // El grupo anterior ya escribio su ':'.
+            if (i == 0) *actual++ = ':';
+            *actual++ = ':';
+            i += largo_ceros - 1;
+            continue;
+        }
+        bool escribiendo = false;
+        for (int desplazamiento = BITS_POR_GRUPO - 4; desplazamiento >= 0; desplazamiento -= 4) {
+            unsigned digito = (grupos[i] >> desplazamiento) & 0xF;
+            if (digito != 0 || escribiendo || desplazamiento == 0) {
+                *actual++ = digitos[digito];
+                escribiendo = true;
+            }
+        }
+        if (i < CANT_GRUPOS - 1) *actual++ = ':';
+    }
+    return actual;
+}
+
+size_t ip_a_cadena(ip_t ip, char* cadena) {
+
+    char* fin = ip_es_v4(ip) ? escribir_v4((uint32_t)ip, cadena) : escribir_v6(ip, cadena);
+    *fin = '\0';
+    return (size_t)(fin - cadena);
+}
+
+void ip_codificar(ip_t ip, uint8_t* bytes) {
+
+    for (size_t i = TAM_IP_BINARIA; i > 0; i--) {
+        bytes[i - 1] = (uint8_t)ip;
+        ip >>= BITS_POR_OCTETO;
+    }
+}
+
+ip_t ip_decodificar(const uint8_t* bytes) {
+
+    ip_t ip = 0;
+    for (size_t i = 0; i < TAM_IP_BINARIA; i++) ip = (ip << BITS_POR_OCTETO) | bytes[i];
+    return ip;
+}
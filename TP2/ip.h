@@ -0,0 +1,48 @@
+#ifndef ALGOS_GITHUB_IP_H
+#define ALGOS_GITHUB_IP_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+//Direccion IP de 128 bits. Las IPv4 se guardan como IPv6 mapeadas (::ffff:a.b.c.d), asi que
+//las dos familias conviven en los mismos conjuntos. El primer byte de la direccion queda en
+//los bits mas significativos, por lo que el orden de los enteros es el orden de las direcciones.
+//Se alinea a 8 bytes para que los nodos y arreglos que la contienen no agreguen relleno.
+__extension__ typedef unsigned __int128 ip_t __attribute__((aligned(8)));
+
+#define BITS_IP 128
+#define IP_MAXIMA (~(ip_t)0)
+
+//Largo maximo de una ip en texto (IPv6 con una IPv4 al final), incluyendo el '\0'.
+#define TAM_IP_CADENA 46
+
+//Largo de la codificacion binaria de una ip.
+#define TAM_IP_BINARIA 16
+
+//Convierte los 'largo' caracteres de 'cadena' en una ip_t. Acepta IPv4 (a.b.c.d) e IPv6
+//en cualquiera de sus formas de texto, con '::' y con una IPv4 en los ultimos 32 bits.
+//Post: devuelve false si la cadena no es una direccion valida.
+bool ip_parsear(const char* cadena, size_t largo, ip_t* ip);
+
+//Convierte un bloque CIDR (a.b.c.d/n con 0 <= n <= 32, o ipv6/n con 0 <= n <= 128) en el
+//rango de ips que abarca. Los bits de la direccion posteriores al prefijo se ignoran.
+//Post: devuelve false si la cadena no es un bloque valido.
+bool ip_parsear_cidr(const char* cadena, size_t largo, ip_t* inicio, ip_t* fin);
+
+//Devuelve true si la ip es una IPv4 (mapeada).
+bool ip_es_v4(ip_t ip);
+
+//Escribe la ip en texto, terminada en '\0': las IPv4 con puntos y las IPv6 en la forma
+//canonica de la RFC 5952. Devuelve la cantidad de caracteres escritos, sin el '\0'.
+//Pre: 'cadena' tiene lugar para TAM_IP_CADENA caracteres.
+size_t ip_a_cadena(ip_t ip, char* cadena);
+
+//Escribe la ip en TAM_IP_BINARIA bytes, del mas significativo al menos significativo,
+//de modo que memcmp entre dos codificaciones respeta el orden de las ips.
+void ip_codificar(ip_t ip, uint8_t* bytes);
+
+//Inversa de ip_codificar.
+ip_t ip_decodificar(const uint8_t* bytes);
+
+#endif //ALGOS_GITHUB_IP_H
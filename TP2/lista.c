@@ -2,6 +2,7 @@
 #include <stdlib.h>
 #include <stdbool.h>
 #include <stdio.h>
+#include "estadisticas.h"
 
 //ALUMNO = STROIA, LAUTARO E. // PADRON 100901 // CORRECTORA ANA CZARNITZKI
 
@@ -34,6 +35,7 @@ struct lista_iter{
 lista_t *lista_crear(void){
 	lista_t* lista = malloc(sizeof(lista_t));
 	if(!lista) return NULL;
+	ESTADISTICAS_SUMAR(CONTADOR_NODOS_CREADOS, 1);
 	lista->primero = NULL;
 	lista->ultimo = NULL;
 	lista->largo = 0;
@@ -55,6 +57,7 @@ bool lista_esta_vacia(const lista_t *lista){
 bool lista_insertar_primero(lista_t *lista, void *dato){
 	nodo_t* nodo = malloc(sizeof(nodo_t));
 	if(!nodo) return false;
+	ESTADISTICAS_SUMAR(CONTADOR_NODOS_CREADOS, 1);
 	nodo->dato = dato;
 	if(lista_esta_vacia(lista)){
 		lista->ultimo = nodo;
@@ -76,6 +79,7 @@ bool lista_insertar_primero(lista_t *lista, void *dato){
 bool lista_insertar_ultimo(lista_t *lista, void *dato){
 	nodo_t* nodo = malloc(sizeof(nodo_t));
 	if(!nodo) return false;
+	ESTADISTICAS_SUMAR(CONTADOR_NODOS_CREADOS, 1);
 	nodo->dato = dato;
 	nodo->proximo = NULL;
 	if(lista_esta_vacia(lista)) lista->primero = nodo;
@@ -167,6 +171,7 @@ void lista_iterar(lista_t *lista, bool visitar(void *dato, void *extra), void *e
 lista_iter_t *lista_iter_crear(lista_t *lista){
 	lista_iter_t* iter =  malloc(sizeof(lista_iter_t));
 	if(!iter) return NULL;
+	ESTADISTICAS_SUMAR(CONTADOR_NODOS_CREADOS, 1);
 	iter->lista = lista;
 	iter->anterior = NULL;
 	if(lista_esta_vacia(lista)){
@@ -217,6 +222,7 @@ bool lista_iter_insertar(lista_iter_t *iter, void *dato){
 	if(!iter) return false;
 	nodo_t* nodo = malloc(sizeof(nodo_t));
 	if(!nodo) return false;
+	ESTADISTICAS_SUMAR(CONTADOR_NODOS_CREADOS, 1);
 	nodo->dato = dato;
 	nodo->proximo = iter->actual;
 	if(lista_esta_vacia(iter->lista)){
@@ -1,22 +1,113 @@
 #define _XOPEN_SOURCE 700
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
 #include "heap.h"
-#include "abb.h"
 #include "visitantes.h"
 #include "recursos.h"
+#include "hyperloglog.h"
 #include "tp2.h"
 
-int main() {
+//Cantidad de recursos mas visitados que se mantienen actualizados durante la carga.
+//Las consultas de ver_mas_visitados de hasta este tamanio no recorren todos los recursos.
+#define CAPACIDAD_TOP_RECURSOS 1000
 
-    abb_t* visitantes = abb_crear((abb_comparar_clave_t)comparar_ips, NULL);
+//Cotas de error por defecto del modo aproximado (-a).
+#define ERROR_CONTEO_POR_DEFECTO 0.0001       // Sobre el total de solicitudes.
+#define PROBABILIDAD_FALLA_POR_DEFECTO 0.01
+#define ERROR_VISITANTES_POR_DEFECTO 0.01     // Relativo a la cantidad de visitantes.
 
-    hash_t* recursos = hash_crear(wrapper_destruir_recurso);
+#define BYTES_POR_MEGABYTE ((size_t)1 << 20)
+
+#define USO "Uso: %s [-a [-e error_conteo] [-d probabilidad_falla] [-v error_visitantes]] [-r reglas_dos] [-m megabytes_dos]\n"
+
+typedef struct opciones {
+    bool aproximado;
+    double error_conteo;
+    double probabilidad_falla;
+    double error_visitantes;
+    const char* reglas_dos;     // Archivo con las reglas de DoS, o NULL para usar la regla por defecto.
+    size_t memoria_dos;         // Limite para la deteccion de DoS en bytes, o 0 si no hay.
+} opciones_t;
+
+//Convierte el argumento de una opcion a un numero estrictamente entre 0 y 1.
+static bool leer_cota(const char* argumento, double* cota) {
+
+    char* fin;
+    double valor = strtod(argumento, &fin);
+    if (fin == argumento || *fin != '\0' || !(valor > 0 && valor < 1)) return false;
+    *cota = valor;
+    return true;
+}
+
+//Convierte el argumento de -m, en megabytes, a una cantidad positiva de bytes.
+static bool leer_megabytes(const char* argumento, size_t* bytes) {
+
+    char* fin;
+    unsigned long long megabytes = strtoull(argumento, &fin, 10);
+    if (fin == argumento || *fin != '\0' || megabytes == 0 || megabytes > SIZE_MAX / BYTES_POR_MEGABYTE) return false;
+    *bytes = (size_t)megabytes * BYTES_POR_MEGABYTE;
+    return true;
+}
+
+//Lee las opciones de la linea de comandos. Devuelve false si alguna es invalida.
+static bool leer_opciones(int argc, char* argv[], opciones_t* opciones) {
+
+    opciones->aproximado = false;
+    opciones->error_conteo = ERROR_CONTEO_POR_DEFECTO;
+    opciones->probabilidad_falla = PROBABILIDAD_FALLA_POR_DEFECTO;
+    opciones->error_visitantes = ERROR_VISITANTES_POR_DEFECTO;
+    opciones->reglas_dos = NULL;
+    opciones->memoria_dos = 0;
+    int opcion;
+    bool ok = true;
+    while (ok && (opcion = getopt(argc, argv, "ae:d:v:r:m:")) != -1) {
+        switch (opcion) {
+            case 'a': opciones->aproximado = true; break;
+            case 'e': ok = leer_cota(optarg, &opciones->error_conteo); break;
+            case 'd': ok = leer_cota(optarg, &opciones->probabilidad_falla); break;
+            case 'v': ok = leer_cota(optarg, &opciones->error_visitantes); break;
+            case 'r': opciones->reglas_dos = optarg; break;
+            case 'm': ok = leer_megabytes(optarg, &opciones->memoria_dos); break;
+            default: ok = false;
+        }
+    }
+    return ok && optind == argc;
+}
+
+int main(int argc, char* argv[]) {
+
+    opciones_t opciones;
+    if (!leer_opciones(argc, argv, &opciones)) {
+        fprintf(stderr, USO, argv[0]);
+        return 1;
+    }
+    if (opciones.reglas_dos != NULL && !dos_cargar_reglas(opciones.reglas_dos)) {
+        fprintf(stderr, "Reglas de DoS invalidas en %s\n", opciones.reglas_dos);
+        return 1;
+    }
+    dos_limitar_memoria(opciones.memoria_dos);
+
+    visitantes_t* visitantes;
+    recursos_t* recursos;
+    if (opciones.aproximado) {
+        visitantes = visitantes_crear_aproximado(hll_precision_para_error(opciones.error_visitantes));
+        recursos = recursos_crear_aproximado(CAPACIDAD_TOP_RECURSOS, opciones.error_conteo, opciones.probabilidad_falla);
+    } else {
+        visitantes = visitantes_crear();
+        recursos = recursos_crear(CAPACIDAD_TOP_RECURSOS);
+    }
+    if (visitantes == NULL || recursos == NULL) {
+        if (recursos != NULL) recursos_destruir(recursos);
+        visitantes_destruir(visitantes);
+        return 1;
+    }
 
     recibir_comandos(visitantes, recursos);
 
-    hash_destruir(recursos);
-    abb_destruir(visitantes);
+    recursos_destruir(recursos);
+    visitantes_destruir(visitantes);
 
     return 0;
-}
\ No newline at end of file
+}
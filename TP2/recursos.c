@@ -1,42 +1,398 @@
 #define _XOPEN_SOURCE 700
 
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include "recursos.h"
+#include "estadisticas.h"
 /***************************************************************************************/
 //Crea un recurso a partir de un nombre.
 //Devuelve ese recurso.
-recurso_t* crear_recurso(char* nombre_recurso) {
+recurso_t* crear_recurso(const char* nombre_recurso) {
     recurso_t *recurso = malloc(sizeof(recurso_t));
     if (recurso== NULL) return NULL;
 
     recurso->clave = strdup(nombre_recurso);
-    if (recurso->clave == NULL) return NULL;
+    if (recurso->clave == NULL) {
+        free(recurso);
+        return NULL;
+    }
+    ESTADISTICAS_SUMAR(CONTADOR_NODOS_CREADOS, 2);
     recurso->cant_de_solicitudes = 0;
+    recurso->posicion_top = NO_ESTA_EN_TOP;
+    recurso->id = ARENA_SIN_ID;
 
     return recurso;
 }
 
-bool aumenta_cont_solicitudes_recurso(hash_t* recursos_mas_solicitados, char* nombre_recurso) {
+//Crea un recurso nuevo para guardar en el hash, que usa el nombre del recurso como clave.
+//En modo exacto el nombre se copia una sola vez, en la arena.
+//Devuelve el recurso, NULL si fallo la memoria.
+static recurso_t* nuevo_recurso(recursos_t* recursos, const char* nombre_recurso) {
 
-    if (!hash_pertenece(recursos_mas_solicitados, nombre_recurso)) {
+    if (recursos->nombres == NULL) return crear_recurso(nombre_recurso);
 
-        recurso_t* recurso = crear_recurso(nombre_recurso);
-        if (recurso == NULL) return false;
-        hash_guardar(recursos_mas_solicitados, nombre_recurso, recurso);
+    recurso_t* recurso = malloc(sizeof(recurso_t));
+    if (recurso == NULL) return NULL;
+    // Si despues no se lo puede guardar en el hash, la copia queda sin usar en la arena hasta destruirla.
+    recurso->clave = arena_cadenas_guardar(recursos->nombres, nombre_recurso, &recurso->id);
+    if (recurso->clave == NULL) {
+        free(recurso);
+        return NULL;
+    }
+    ESTADISTICAS_SUMAR(CONTADOR_NODOS_CREADOS, 1);
+    recurso->cant_de_solicitudes = 0;
+    recurso->posicion_top = NO_ESTA_EN_TOP;
+    return recurso;
+}
+
+//Adapta nuevo_recurso a hash_obtener_o_insertar_con_clave: la clave que se guarda es el nombre del recurso.
+static void* crear_recurso_para_hash(const char* clave, const char** guardada, void* recursos) {
+
+    recurso_t* recurso = nuevo_recurso(recursos, clave);
+    if (recurso != NULL) *guardada = recurso->clave;
+    return recurso;
+}
+
+//Crea un recurso nuevo y lo guarda en el hash.
+//Devuelve el recurso, NULL si fallo la memoria.
+static recurso_t* agregar_recurso(recursos_t* recursos, const char* nombre_recurso) {
+
+    recurso_t* recurso = nuevo_recurso(recursos, nombre_recurso);
+    if (recurso == NULL) return NULL;
+    if (!hash_guardar(recursos->hash, recurso->clave, recurso)) {
+        if (recursos->nombres == NULL) destruir_recurso(recurso);
+        else free(recurso);
+        return NULL;
+    }
+    return recurso;
+}
+
+//Crea la estructura vacia. El hash nunca copia las claves: usa el nombre del recurso, que
+//esta en la arena si 'con_nombres' es true o es una copia propia del recurso si no.
+static recursos_t* recursos_crear_base(size_t capacidad_top, bool con_nombres) {
+
+    recursos_t* recursos = malloc(sizeof(recursos_t));
+    if (recursos == NULL) return NULL;
+    recursos->hash = hash_crear_sin_copiar_claves(con_nombres ? free : wrapper_destruir_recurso);
+    recursos->nombres = con_nombres ? arena_cadenas_crear() : NULL;
+    recursos->por_minuto = con_nombres ? indice_temporal_crear() : NULL;
+    recursos->top = capacidad_top > 0 ? malloc(sizeof(recurso_t*) * capacidad_top) : NULL;
+    if (recursos->hash == NULL || (con_nombres && (recursos->nombres == NULL || recursos->por_minuto == NULL))
+        || (capacidad_top > 0 && recursos->top == NULL)) {
+        if (recursos->hash != NULL) hash_destruir(recursos->hash);
+        arena_cadenas_destruir(recursos->nombres);
+        indice_temporal_destruir(recursos->por_minuto);
+        free(recursos->top);
+        free(recursos);
+        return NULL;
+    }
+    recursos->cantidad_top = 0;
+    recursos->capacidad_top = capacidad_top;
+    recursos->conteo = NULL;
+    return recursos;
+}
+
+recursos_t* recursos_crear(size_t capacidad_top) {
+
+    return recursos_crear_base(capacidad_top, true);
+}
+
+//Crea la estructura aproximada alrededor de un sketch ya creado, del que pasa a ser duenia.
+static recursos_t* recursos_crear_con_sketch(size_t capacidad_top, count_min_t* conteo) {
+
+    if (conteo == NULL) return NULL;
+    recursos_t* recursos = capacidad_top > 0 ? recursos_crear_base(capacidad_top, false) : NULL;
+    if (recursos == NULL) {
+        count_min_destruir(conteo);
+        return NULL;
+    }
+    recursos->conteo = conteo;
+    return recursos;
+}
+
+recursos_t* recursos_crear_aproximado(size_t capacidad_top, double error, double probabilidad_falla) {
+
+    return recursos_crear_con_sketch(capacidad_top, count_min_crear(error, probabilidad_falla));
+}
+
+recursos_t* recursos_crear_como(const recursos_t* modelo) {
+
+    if (modelo->conteo == NULL) return recursos_crear(0);
+    return recursos_crear_con_sketch(modelo->capacidad_top, count_min_crear_como(modelo->conteo));
+}
+
+bool recursos_es_aproximado(const recursos_t* recursos) {
+
+    return recursos->conteo != NULL;
+}
+
+void recursos_destruir(recursos_t* recursos) {
+
+    hash_destruir(recursos->hash);
+    arena_cadenas_destruir(recursos->nombres);
+    indice_temporal_destruir(recursos->por_minuto);
+    free(recursos->top);
+    count_min_destruir(recursos->conteo);
+    free(recursos);
+}
+
+/*********************** HEAP DE MINIMOS INDEXADO DEL TOP ***********************/
+
+//Ubica el recurso en la posicion del heap, actualizando su indice.
+static void top_ubicar(recursos_t* recursos, recurso_t* recurso, size_t posicion) {
+
+    recursos->top[posicion] = recurso;
+    recurso->posicion_top = posicion;
+}
+
+//Sube el recurso de la posicion dada mientras tenga menos solicitudes que su padre.
+static void top_upheap(recursos_t* recursos, size_t posicion) {
+
+    recurso_t* recurso = recursos->top[posicion];
+    while (posicion > 0) {
+        size_t padre = (posicion - 1) / 2;
+        if (recursos->top[padre]->cant_de_solicitudes <= recurso->cant_de_solicitudes) break;
+        top_ubicar(recursos, recursos->top[padre], posicion);
+        posicion = padre;
     }
-    ((recurso_t *) (hash_obtener(recursos_mas_solicitados, nombre_recurso)))->cant_de_solicitudes++;
+    top_ubicar(recursos, recurso, posicion);
+}
+
+//Baja el recurso de la posicion dada mientras tenga mas solicitudes que alguno de sus hijos.
+static void top_downheap(recursos_t* recursos, size_t posicion) {
+
+    recurso_t* recurso = recursos->top[posicion];
+    while (true) {
+        size_t menor = 2 * posicion + 1;
+        if (menor >= recursos->cantidad_top) break;
+        if (menor + 1 < recursos->cantidad_top
+            && recursos->top[menor + 1]->cant_de_solicitudes < recursos->top[menor]->cant_de_solicitudes) menor++;
+        if (recurso->cant_de_solicitudes <= recursos->top[menor]->cant_de_solicitudes) break;
+        top_ubicar(recursos, recursos->top[menor], posicion);
+        posicion = menor;
+    }
+    top_ubicar(recursos, recurso, posicion);
+}
+
+//Actualiza el top despues de que aumentaron las solicitudes del recurso. Como los contadores
+//solo crecen, todos los recursos fuera del top tienen a lo sumo las solicitudes del minimo;
+//alcanza con comparar contra la raiz para saber si el recurso entra.
+//Devuelve el recurso que salio del top para hacerle lugar, o NULL si no salio ninguno.
+static recurso_t* top_actualizar(recursos_t* recursos, recurso_t* recurso) {
+
+    if (recursos->capacidad_top == 0) return NULL;
+    if (recurso->posicion_top != NO_ESTA_EN_TOP) {
+        top_downheap(recursos, recurso->posicion_top);
+    } else if (recursos->cantidad_top < recursos->capacidad_top) {
+        recursos->top[recursos->cantidad_top] = recurso;
+        recursos->cantidad_top++;
+        top_upheap(recursos, recursos->cantidad_top - 1);
+    } else if (recurso->cant_de_solicitudes > recursos->top[0]->cant_de_solicitudes) {
+        recurso_t* desplazado = recursos->top[0];
+        desplazado->posicion_top = NO_ESTA_EN_TOP;
+        top_ubicar(recursos, recurso, 0);
+        top_downheap(recursos, 0);
+        return desplazado;
+    }
+    return NULL;
+}
 
+//Devuelve true si un recurso fuera del top con esa cantidad de solicitudes entraria en el.
+static bool top_admite(const recursos_t* recursos, int cant_de_solicitudes) {
+
+    return recursos->cantidad_top < recursos->capacidad_top
+        || cant_de_solicitudes > recursos->top[0]->cant_de_solicitudes;
+}
+
+//Baja el recurso de la posicion dada en un heap de minimos de 'cantidad' recursos que no
+//es el top (no actualiza posicion_top).
+static void seleccion_downheap(recurso_t** heap, size_t cantidad, size_t posicion) {
+
+    recurso_t* recurso = heap[posicion];
+    while (true) {
+        size_t menor = 2 * posicion + 1;
+        if (menor >= cantidad) break;
+        if (menor + 1 < cantidad && heap[menor + 1]->cant_de_solicitudes < heap[menor]->cant_de_solicitudes) menor++;
+        if (recurso->cant_de_solicitudes <= heap[menor]->cant_de_solicitudes) break;
+        heap[posicion] = heap[menor];
+        posicion = menor;
+    }
+    heap[posicion] = recurso;
+}
+
+//Deja en 'destino' los k recursos del top con mas solicitudes, de mayor a menor, sin pedir
+//memoria: arma en 'destino' un heap de minimos de k recursos y solo reemplaza su raiz con
+//los del top que la superan. Despues ordena esos k.
+//Devuelve la cantidad guardada (el top puede tener menos de k).
+static size_t top_seleccionar(const recursos_t* recursos, recurso_t** destino, size_t k) {
+
+    size_t cantidad = k < recursos->cantidad_top ? k : recursos->cantidad_top;
+    memcpy(destino, recursos->top, sizeof(recurso_t*) * cantidad);
+    for (size_t i = cantidad / 2; i > 0; i--) seleccion_downheap(destino, cantidad, i - 1);
+    for (size_t i = cantidad; i < recursos->cantidad_top; i++) {
+        if (recursos->top[i]->cant_de_solicitudes <= destino[0]->cant_de_solicitudes) continue;
+        destino[0] = recursos->top[i];
+        seleccion_downheap(destino, cantidad, 0);
+    }
+    // comparar_recursos esta invertida, asi que el orden queda de mayor a menor cantidad.
+    if (cantidad > 1) heap_sort((void**)destino, cantidad, (cmp_func_t)comparar_recursos);
+    return cantidad;
+}
+
+//Rearma el heap del top despues de cambiar varios contadores a la vez.
+static void top_reordenar(recursos_t* recursos) {
+
+    for (size_t i = recursos->cantidad_top / 2; i > 0; i--) {
+        top_downheap(recursos, i - 1);
+    }
+}
+
+/***************************** MODO APROXIMADO *****************************/
+
+//Pasa la estimacion del sketch a la escala de los contadores de recurso_t.
+static int estimacion_a_cantidad(uint32_t estimacion) {
+
+    return estimacion > INT_MAX ? INT_MAX : (int)estimacion;
+}
+
+//Actualiza la cantidad estimada de un recurso y, si esta o entra en el top, lo deja
+//guardado en el hash; el recurso que sale del top se borra, porque su cuenta queda en el sketch.
+static bool ofrecer_candidato(recursos_t* recursos, const char* nombre_recurso, int estimacion) {
+
+    recurso_t* recurso = hash_obtener(recursos->hash, nombre_recurso);
+    if (recurso == NULL) {
+        if (!top_admite(recursos, estimacion)) return true;
+        recurso = agregar_recurso(recursos, nombre_recurso);
+        if (recurso == NULL) return false;
+    }
+    recurso->cant_de_solicitudes = estimacion;
+    recurso_t* desplazado = top_actualizar(recursos, recurso);
+    if (desplazado != NULL) destruir_recurso(hash_borrar(recursos->hash, desplazado->clave));
     return true;
 }
 
+//Fusiona dos estructuras aproximadas: suma los sketches, reestima los candidatos de destino
+//y ofrece los de origen con su estimacion sobre el sketch sumado.
+static bool recursos_fusionar_aproximado(recursos_t* destino, const recursos_t* origen) {
+
+    count_min_fusionar(destino->conteo, origen->conteo);
+    for (size_t i = 0; i < destino->cantidad_top; i++) {
+        recurso_t* recurso = destino->top[i];
+        recurso->cant_de_solicitudes = estimacion_a_cantidad(count_min_estimar(destino->conteo, recurso->clave));
+    }
+    top_reordenar(destino);
+
+    bool ok = true;
+    for (size_t i = 0; i < origen->cantidad_top; i++) {
+        const char* clave = origen->top[i]->clave;
+        ok = ofrecer_candidato(destino, clave, estimacion_a_cantidad(count_min_estimar(destino->conteo, clave))) && ok;
+    }
+    return ok;
+}
+
+/********************************************************************************/
+
+//Suma solicitudes al recurso en modo exacto, creandolo si no existia.
+//Devuelve el recurso, NULL si fallo la memoria.
+static recurso_t* sumar_solicitudes_exacto(recursos_t* recursos, const char* nombre_recurso, int cantidad) {
+
+    void** dato = hash_obtener_o_insertar_con_clave(recursos->hash, nombre_recurso, crear_recurso_para_hash, recursos);
+    if (dato == NULL) return NULL;
+    recurso_t* recurso = *dato;
+    recurso->cant_de_solicitudes += cantidad;
+    top_actualizar(recursos, recurso);
+    return recurso;
+}
+
+bool sumar_solicitudes_recurso(recursos_t* recursos_mas_solicitados, const char* nombre_recurso, int cantidad) {
+
+    if (recursos_mas_solicitados->conteo != NULL) {
+        uint32_t estimacion = count_min_sumar(recursos_mas_solicitados->conteo, nombre_recurso, (uint32_t)cantidad);
+        return ofrecer_candidato(recursos_mas_solicitados, nombre_recurso, estimacion_a_cantidad(estimacion));
+    }
+    return sumar_solicitudes_exacto(recursos_mas_solicitados, nombre_recurso, cantidad) != NULL;
+}
+
+bool registrar_visita_recurso(recursos_t* recursos_mas_solicitados, const char* nombre_recurso, ip_t ip, const time_t* instante) {
+
+    if (recursos_mas_solicitados->por_minuto == NULL) return sumar_solicitudes_recurso(recursos_mas_solicitados, nombre_recurso, 1);
+    recurso_t* recurso = sumar_solicitudes_exacto(recursos_mas_solicitados, nombre_recurso, 1);
+    if (recurso == NULL) return false;
+    return instante == NULL || indice_temporal_registrar(recursos_mas_solicitados->por_minuto, *instante, recurso->id, ip);
+}
+
+bool aumenta_cont_solicitudes_recurso(recursos_t* recursos_mas_solicitados, const char* nombre_recurso) {
+
+    return sumar_solicitudes_recurso(recursos_mas_solicitados, nombre_recurso, 1);
+}
+
+bool recursos_fusionar(recursos_t* destino, const recursos_t* origen) {
+
+    if (destino->conteo != NULL && origen->conteo != NULL) return recursos_fusionar_aproximado(destino, origen);
+    // Para fusionar los indices por minuto se traducen los ids de la arena de origen a los de destino.
+    bool con_indice = destino->por_minuto != NULL && origen->por_minuto != NULL;
+    uint32_t* ids_en_destino = NULL;
+    if (con_indice) {
+        size_t cantidad_ids = arena_cadenas_cantidad(origen->nombres);
+        ids_en_destino = malloc(sizeof(uint32_t) * (cantidad_ids > 0 ? cantidad_ids : 1));
+        if (ids_en_destino == NULL) return false;
+    }
+    hash_iter_t* iter = hash_iter_crear(origen->hash);
+    if (iter == NULL) {
+        free(ids_en_destino);
+        return false;
+    }
+    bool ok = true;
+    while (!hash_iter_al_final(iter)) {
+        const char* clave = hash_iter_ver_actual(iter);
+        recurso_t* recurso = hash_obtener(origen->hash, clave);
+        if (con_indice) {
+            recurso_t* en_destino = sumar_solicitudes_exacto(destino, clave, recurso->cant_de_solicitudes);
+            if (en_destino != NULL) ids_en_destino[recurso->id] = en_destino->id;
+            ok = en_destino != NULL && ok;
+        } else {
+            ok = sumar_solicitudes_recurso(destino, clave, recurso->cant_de_solicitudes) && ok;
+        }
+        hash_iter_avanzar(iter);
+    }
+    hash_iter_destruir(iter);
+    if (con_indice && ok) ok = indice_temporal_fusionar(destino->por_minuto, origen->por_minuto, ids_en_destino);
+    free(ids_en_destino);
+    return ok;
+}
+
+size_t obtener_mas_solicitados(recursos_t* recursos_mas_solicitados, recurso_t** destino, size_t k) {
+
+    if (k == 0) return 0;
+    if (k <= recursos_mas_solicitados->capacidad_top) return top_seleccionar(recursos_mas_solicitados, destino, k);
+
+    heap_t* recursos_temp = heap_crear((cmp_func_t)comparar_recursos);
+    if (recursos_temp == NULL) return 0;
+    pasar_top_k_de_hash_a_heap(recursos_mas_solicitados->hash, recursos_temp, (int)k);
+    // El heap es de minimos: se desencolan de menor a mayor y se guardan desde el final.
+    size_t cantidad = heap_cantidad(recursos_temp);
+    for (size_t i = cantidad; i > 0; i--) {
+        destino[i - 1] = heap_desencolar(recursos_temp);
+    }
+    heap_destruir(recursos_temp, NULL);
+    return cantidad;
+}
+
 int comparar_recursos(recurso_t* recurso1, recurso_t* recurso2){
 
     //Comparo la cantidad de solicitudes de cada recurso
-    return recurso2->cant_de_solicitudes - recurso1->cant_de_solicitudes;
+    if (recurso1->cant_de_solicitudes != recurso2->cant_de_solicitudes) {
+        return recurso1->cant_de_solicitudes > recurso2->cant_de_solicitudes ? -1 : 1;
+    }
+    //Los empates se ordenan por nombre, para no depender del orden del hash (que cambia con la semilla)
+    return strcmp(recurso1->clave, recurso2->clave);
 }
 
 //Funcion encargada de destruir un recurso.
 void destruir_recurso(recurso_t* recurso) {
-    free(recurso->clave);
+    free((char*)recurso->clave);
     free(recurso);
 }
 
@@ -47,20 +403,6 @@ void wrapper_destruir_recurso(void* dato) {
     destruir_recurso(recurso);
 }
 
-//Dado un heap temporal de recursos y una cantidad "N", imprime por pantalla los
-//N sitios mas visitados de la pagina.
-void mostrar_n_recursos(heap_t* recursos_temp, int cantidad_de_recursos_a_mostrar) {
-
-    if(cantidad_de_recursos_a_mostrar == 0) return;
-
-    recurso_t* sitio_visitado = (recurso_t*)heap_desencolar(recursos_temp);
-    if (sitio_visitado == NULL) return;
-
-    mostrar_n_recursos(recursos_temp,cantidad_de_recursos_a_mostrar-1);
-    printf("\t%s - %d\n", sitio_visitado->clave, sitio_visitado->cant_de_solicitudes);
-}
-
-
 void pasar_top_k_de_hash_a_heap(hash_t* hash, heap_t* heap, int k) {
 
     hash_iter_t* iter_hash = hash_iter_crear(hash);
@@ -1,36 +1,108 @@
 #ifndef ALGOS_GITHUB_RECURSOS_H
 #define ALGOS_GITHUB_RECURSOS_H
 
-#include "tp2.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "hash.h"
+#include "heap.h"
+#include "count_min.h"
+#include "arena_cadenas.h"
+#include "indice_temporal.h"
 
 
 typedef struct recurso {
-    char *clave;
+    const char *clave;
     int cant_de_solicitudes;
+    size_t posicion_top;    // Posicion en el heap del top, o NO_ESTA_EN_TOP.
+    uint32_t id;            // Id del nombre en la arena de recursos, o ARENA_SIN_ID.
 }recurso_t;
 
+//Recursos solicitados, indexados por nombre en un hash. Ademas se mantiene un heap
+//de minimos con los 'capacidad_top' recursos mas solicitados, que se actualiza a medida
+//que aumentan los contadores; asi las consultas de hasta ese tamanio no recorren el hash.
+//En modo exacto cada nombre se guarda una sola vez, en la arena: el recurso y el hash
+//comparten esa copia, y el id del recurso es el de su nombre en la arena. Ademas se
+//indexan las solicitudes por minuto, para las consultas sobre un intervalo de tiempo.
+//En modo aproximado los contadores viven en un sketch Count-Min y el hash guarda solo
+//los recursos que estan en el top, con su cantidad estimada.
+typedef struct recursos {
+    hash_t* hash;
+    recurso_t** top;
+    size_t cantidad_top;
+    size_t capacidad_top;
+    count_min_t* conteo;    // NULL en modo exacto.
+    arena_cadenas_t* nombres;   // NULL en modo aproximado, donde cada recurso es duenio de su nombre.
+    indice_temporal_t* por_minuto;  // NULL en modo aproximado.
+} recursos_t;
+
+#define NO_ESTA_EN_TOP ((size_t)-1)
 
 /***************************************************************************/
 
-// Crea un recurso_t con la cadena pasada por parametro.
+// Crea la estructura de recursos, manteniendo el top de los 'capacidad_top' mas
+// solicitados (con 0 no se mantiene ningun top).
+// Post: devuelve la estructura vacia, NULL si algo fallo.
+recursos_t* recursos_crear(size_t capacidad_top);
+
+// Crea la estructura de recursos en modo aproximado: cuenta con un sketch Count-Min con
+// las cotas de error pedidas y solo guarda los 'capacidad_top' (mayor a 0) mas solicitados.
+// Post: devuelve la estructura vacia, NULL si los parametros son invalidos o algo fallo.
+recursos_t* recursos_crear_aproximado(size_t capacidad_top, double error, double probabilidad_falla);
+
+// Crea una estructura vacia que se pueda fusionar en 'modelo': sin top si es exacta, o
+// con el mismo sketch y el mismo tamanio de top si es aproximada.
+recursos_t* recursos_crear_como(const recursos_t* modelo);
+
+// Devuelve true si los contadores de la estructura son estimaciones.
+bool recursos_es_aproximado(const recursos_t* recursos);
+
+// Pre: recursos fue creado.
+// Destruye la estructura junto con todos sus recursos.
+void recursos_destruir(recursos_t* recursos);
+
+// Crea un recurso_t con una copia propia de la cadena pasada por parametro.
 // Post: Devuelve un elemento del tipo recurso_t si se
 // creo sin problemas, NULL en caso de que algo halla fallado
-recurso_t* crear_recurso(char* nombre_recurso);
+recurso_t* crear_recurso(const char* nombre_recurso);
 
 // Pre: recursos_mas_solicitado fue creado
-// Dado un hash, el cual contiene el nombre de un recurso como clave y un recurso_t,
-// asociado a esa clave como valor. Aumenta en uno el numero de solicitudes de dicho recurso.
+// Aumenta en uno el numero de solicitudes del recurso, creandolo si no existia.
 // Post: devuelve true o false dependiendo de si la operacion se efectuo correctamente. Se
 // aumento en uno el contador de solicitudes de dicho recurso.
-bool aumenta_cont_solicitudes_recurso(hash_t* recursos_mas_solicitados, char* recurso);
+bool aumenta_cont_solicitudes_recurso(recursos_t* recursos_mas_solicitados, const char* recurso);
+
+// Pre: recursos_mas_solicitados fue creado.
+// Aumenta en uno las solicitudes del recurso y, si hay indice por minuto y se conoce el
+// instante de la solicitud (no es NULL), la registra en el indice junto con la ip.
+// Post: devuelve false si algo fallo.
+bool registrar_visita_recurso(recursos_t* recursos_mas_solicitados, const char* recurso, ip_t ip, const time_t* instante);
+
+// Pre: recursos_mas_solicitados fue creado.
+// Igual que aumenta_cont_solicitudes_recurso, pero suma 'cantidad' solicitudes de una vez.
+bool sumar_solicitudes_recurso(recursos_t* recursos_mas_solicitados, const char* recurso, int cantidad);
+
+// Pre: destino y origen fueron creados, origen con recursos_crear_como(destino).
+// Suma a destino las solicitudes de cada recurso de origen.
+// Post: devuelve false si algun recurso no se pudo agregar.
+bool recursos_fusionar(recursos_t* destino, const recursos_t* origen);
+
+// Pre: recursos_mas_solicitados fue creado, 'destino' tiene lugar para k recursos.
+// Guarda en 'destino' los k recursos mas solicitados, de mayor a menor. Si k no supera
+// el tamanio del top mantenido, se seleccionan del top sin pedir memoria, en O(C log k) para
+// un top de C recursos y ordenando solo los k elegidos; si no, se recorre el hash.
+// Post: devuelve la cantidad de recursos guardados (puede haber menos de k).
+size_t obtener_mas_solicitados(recursos_t* recursos_mas_solicitados, recurso_t** destino, size_t k);
 
 // Pre: recurso1 y recurso2 fueron creados
 // Funcion de comparacion de recurso_t, hecho para un heap de minimos, por lo que los
 // valores de retorno estan invertidos.
-// Post: Devuelve -1 si el recurso1 es mayor a recurso2; 1 en viceversa; 0 si coinciden.
+// Con la misma cantidad de solicitudes, es mayor el de nombre menor.
+// Post: Devuelve un valor negativo si el recurso1 es mayor a recurso2; positivo en
+// viceversa; 0 si coinciden.
 int comparar_recursos(recurso_t* recurso1, recurso_t* recurso2);
 
-// Pre: recurso fue creado.
+// Pre: recurso fue creado con crear_recurso.
 // Destruye el recurso recibido por parametro.
 // Post: recurso fue destruido.
 void destruir_recurso(recurso_t* recurso);
@@ -39,10 +111,6 @@ void destruir_recurso(recurso_t* recurso);
 // para que sea generica y pueda ser recibida como parametros por otras funciones.
 void wrapper_destruir_recurso(void* dato);
 
-//Dado un heap temporal de recursos y una cantidad "N", imprime por pantalla los
-//N sitios mas visitados de la pagina.
-void mostrar_n_recursos(heap_t* recursos_temp, int cantidad_de_recursos_a_mostrar);
-
 // Pasa los top k elementos de hash hacia un heap de minimos con cantidad de elementos igual a k.
 void pasar_top_k_de_hash_a_heap(hash_t* hash, heap_t* heap, int k);
 
@@ -0,0 +1,57 @@
+#include <stdlib.h>
+#include <string.h>
+#include "registro.h"
+
+#define SEPARADOR_CAMPOS '\t'
+#define CAPACIDAD_INICIAL_BUFFER 256
+/***************************************************************************************/
+
+//Toma el campo que empieza en 'inicio' y termina en el proximo separador o en 'fin'.
+//Devuelve un puntero al caracter siguiente al separador, o 'fin' si no lo habia.
+static const char* siguiente_campo(const char* inicio, const char* fin, campo_t* campo) {
+
+    const char* separador = memchr(inicio, SEPARADOR_CAMPOS, (size_t)(fin - inicio));
+    campo->inicio = inicio;
+    if (separador == NULL) {
+        campo->largo = (size_t)(fin - inicio);
+        return fin;
+    }
+    campo->largo = (size_t)(separador - inicio);
+    return separador + 1;
+}
+
+bool parsear_registro(const char* linea, size_t largo, registro_t* registro) {
+
+    const char* fin = linea + largo;
+    const char* actual = linea;
+    actual = siguiente_campo(actual, fin, &registro->ip);
+    if (actual == fin) return false;
+    actual = siguiente_campo(actual, fin, &registro->fecha);
+    if (actual == fin) return false;
+    actual = siguiente_campo(actual, fin, &registro->metodo);
+    if (actual == fin) return false;
+    siguiente_campo(actual, fin, &registro->recurso);
+    return true;
+}
+
+const char* campo_a_cadena(campo_t campo, buffer_campo_t* buffer) {
+
+    if (campo.largo + 1 > buffer->capacidad) {
+        size_t nueva_capacidad = buffer->capacidad > 0 ? buffer->capacidad : CAPACIDAD_INICIAL_BUFFER;
+        while (nueva_capacidad < campo.largo + 1) nueva_capacidad *= 2;
+        char* datos = realloc(buffer->datos, nueva_capacidad);
+        if (datos == NULL) return NULL;
+        buffer->datos = datos;
+        buffer->capacidad = nueva_capacidad;
+    }
+    memcpy(buffer->datos, campo.inicio, campo.largo);
+    buffer->datos[campo.largo] = '\0';
+    return buffer->datos;
+}
+
+void buffer_campo_destruir(buffer_campo_t* buffer) {
+
+    free(buffer->datos);
+    buffer->datos = NULL;
+    buffer->capacidad = 0;
+}
@@ -0,0 +1,47 @@
+#ifndef ALGOS_GITHUB_REGISTRO_H
+#define ALGOS_GITHUB_REGISTRO_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+/*******************************************************************
+ *                DEFINICION DE LOS TIPOS DE DATOS                 *
+ ******************************************************************/
+
+//Porcion de una linea del log. No esta terminada en '\0' ni es duenia
+//de la memoria a la que apunta.
+typedef struct campo {
+    const char* inicio;
+    size_t largo;
+} campo_t;
+
+//Campos de una linea del log: <ip>\t<fecha>\t<metodo>\t<recurso>
+typedef struct registro {
+    campo_t ip;
+    campo_t fecha;
+    campo_t metodo;
+    campo_t recurso;
+} registro_t;
+
+//Buffer reutilizable para obtener un campo como cadena terminada en '\0'.
+typedef struct buffer_campo {
+    char* datos;
+    size_t capacidad;
+} buffer_campo_t;
+
+/*******************************************************************
+*                           PRIMITIVAS                             *
+*******************************************************************/
+
+//Separa una linea del log (sin el salto de linea) en sus campos, sin copiarlos.
+//Post: devuelve false si la linea no tiene los cuatro campos separados por tabs.
+bool parsear_registro(const char* linea, size_t largo, registro_t* registro);
+
+//Copia el campo en el buffer, agrandandolo solo si no alcanza, y lo termina en '\0'.
+//Post: devuelve la cadena dentro del buffer, NULL si fallo la memoria.
+const char* campo_a_cadena(campo_t campo, buffer_campo_t* buffer);
+
+//Libera la memoria del buffer.
+void buffer_campo_destruir(buffer_campo_t* buffer);
+
+#endif //ALGOS_GITHUB_REGISTRO_H
@@ -0,0 +1,83 @@
+#define _XOPEN_SOURCE 700
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include "salida.h"
+
+#define MAX_DIGITOS_ENTERO 20
+
+//Escribe todo el buffer, reintentando las escrituras parciales o interrumpidas.
+static void escribir_buffer(salida_t* salida) {
+
+    size_t escritos = 0;
+    while (!salida->error && escritos < salida->usado) {
+        ssize_t resultado = write(salida->descriptor, salida->datos + escritos, salida->usado - escritos);
+        if (resultado > 0) escritos += (size_t)resultado;
+        else if (resultado == -1 && errno != EINTR) salida->error = true;
+    }
+    salida->usado = 0;
+}
+
+//Se asegura de que entren 'largo' bytes mas en el buffer (largo <= TAM_BUFFER_SALIDA).
+static void reservar(salida_t* salida, size_t largo) {
+
+    if (TAM_BUFFER_SALIDA - salida->usado < largo) escribir_buffer(salida);
+}
+
+void salida_inicializar(salida_t* salida, int descriptor) {
+
+    fflush(stdout);
+    salida->descriptor = descriptor;
+    salida->usado = 0;
+    salida->error = false;
+}
+
+void salida_cadena(salida_t* salida, const char* cadena) {
+
+    size_t largo = strlen(cadena);
+    while (largo > 0) {
+        reservar(salida, 1);
+        size_t lugar = TAM_BUFFER_SALIDA - salida->usado;
+        size_t copiar = largo < lugar ? largo : lugar;
+        memcpy(salida->datos + salida->usado, cadena, copiar);
+        salida->usado += copiar;
+        cadena += copiar;
+        largo -= copiar;
+    }
+}
+
+void salida_caracter(salida_t* salida, char caracter) {
+
+    reservar(salida, 1);
+    salida->datos[salida->usado++] = caracter;
+}
+
+void salida_entero(salida_t* salida, int64_t numero) {
+
+    // Se trabaja con el valor absoluto sin signo, que tambien representa a INT64_MIN.
+    uint64_t valor = numero < 0 ? 0 - (uint64_t)numero : (uint64_t)numero;
+    char digitos[MAX_DIGITOS_ENTERO];
+    size_t cantidad = 0;
+    do {
+        digitos[cantidad++] = (char)('0' + valor % 10);
+        valor /= 10;
+    } while (valor > 0);
+
+    reservar(salida, cantidad + 1);
+    if (numero < 0) salida->datos[salida->usado++] = '-';
+    while (cantidad > 0) salida->datos[salida->usado++] = digitos[--cantidad];
+}
+
+void salida_ip(salida_t* salida, ip_t ip) {
+
+    reservar(salida, TAM_IP_CADENA);
+    salida->usado += ip_a_cadena(ip, salida->datos + salida->usado);
+}
+
+bool salida_volcar(salida_t* salida) {
+
+    escribir_buffer(salida);
+    return !salida->error;
+}
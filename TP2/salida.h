@@ -0,0 +1,45 @@
+#ifndef ALGOS_GITHUB_SALIDA_H
+#define ALGOS_GITHUB_SALIDA_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "ip.h"
+
+#define TAM_BUFFER_SALIDA (1 << 16)
+
+//Escritor con buffer propio para los resultados grandes: formatea enteros e ips a mano
+//dentro del buffer y lo escribe en el descriptor de a bloques grandes, sin pasar por
+//stdio ni pedir memoria. Se declara en la pila de quien imprime.
+typedef struct salida {
+    int descriptor;
+    size_t usado;
+    bool error;
+    char datos[TAM_BUFFER_SALIDA];
+} salida_t;
+
+/*******************************************************************
+*                           PRIMITIVAS                             *
+*******************************************************************/
+
+//Prepara la salida sobre el descriptor. Antes vacia stdout, para que lo que ya se
+//imprimio con stdio salga antes que lo que se escriba por la salida.
+void salida_inicializar(salida_t* salida, int descriptor);
+
+//Agrega una cadena terminada en '\0'.
+void salida_cadena(salida_t* salida, const char* cadena);
+
+//Agrega un caracter.
+void salida_caracter(salida_t* salida, char caracter);
+
+//Agrega un entero en decimal.
+void salida_entero(salida_t* salida, int64_t numero);
+
+//Agrega una ip en texto, con el formato de ip_a_cadena.
+void salida_ip(salida_t* salida, ip_t ip);
+
+//Escribe lo que queda en el buffer.
+//Post: devuelve false si alguna escritura desde que se inicializo la salida fallo.
+bool salida_volcar(salida_t* salida);
+
+#endif //ALGOS_GITHUB_SALIDA_H
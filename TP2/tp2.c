@@ -1,34 +1,151 @@
 
+#include <errno.h>
+#include <glob.h>
+#include <poll.h>
 #include "tp2.h"
 #include "hash.h"
 #include "lista.h"
 #include "heap.h"
 #include "strutil.h"
-#include "abb.h"
 
 #define AGREGAR_ARCHIVO "agregar_archivo"
 #define VISITANTES "ver_visitantes"
 #define VISITADOS "ver_mas_visitados"
+#define GUARDAR_ESTADO "guardar_estado"
+#define CARGAR_ESTADO "cargar_estado"
+#define CONTAR_VISITANTES "contar_visitantes"
+#define VISITADOS_ENTRE "ver_mas_visitados_entre"
+#define VISITANTES_ENTRE "ver_visitantes_entre"
+#define ESTADISTICAS "estadisticas"
+#define SEGUIR_ARCHIVO "seguir_archivo"
 
 #define CANT_PARAM_AGREGAR 2
 #define CANT_PARAM_VISITANTES 3
+#define CANT_PARAM_VISITANTES_CIDR 2
 #define CANT_PARAM_VISITADOS 2
+#define CANT_PARAM_ESTADO 2
+#define CANT_PARAM_CONTAR_VISITANTES 1
+#define CANT_PARAM_CONTAR_VISITANTES_RANGO 3
+#define CANT_PARAM_VISITADOS_ENTRE 4
+#define CANT_PARAM_VISITANTES_ENTRE 3
+#define CANT_PARAM_ESTADISTICAS 1
+#define CANT_PARAM_SEGUIR 2
 
 #define CANT_POS_ARRAY_IP 4
 
 #define TAM_BUFFER 300
 
+//Cada cuanto se revisan los archivos seguidos mientras no llegan comandos.
+#define INTERVALO_SEGUIMIENTO_MS 100
+
 /**************************************************************************************/
 
-void recibir_comandos(abb_t* visitantes, hash_t* recursos_mas_solicitados) {
-    
+//Comandos leidos de la entrada estandar que todavia no se procesaron. Se lee con read y
+//no con fgets porque poll no ve lo que ya quedo en el buffer de stdin.
+typedef struct entrada {
+    char datos[TAM_BUFFER];
+    size_t usados;
+    bool terminada;
+} entrada_t;
+
+//Copia en 'linea' el proximo comando completo, sin el salto de linea, y lo saca de la entrada.
+//Como con fgets, una linea de mas de TAM_BUFFER - 1 caracteres se parte en varias.
+//Al terminar la entrada tambien devuelve lo que quede, aunque no tenga salto de linea.
+static bool tomar_linea(entrada_t* entrada, char* linea) {
+
+    char* salto = memchr(entrada->datos, '\n', entrada->usados);
+    size_t largo;
+    if (salto != NULL) largo = (size_t)(salto - entrada->datos);
+    else if (entrada->usados == TAM_BUFFER - 1 || (entrada->terminada && entrada->usados > 0)) largo = entrada->usados;
+    else return false;
+
+    memcpy(linea, entrada->datos, largo);
+    linea[largo] = '\0';
+    size_t consumidos = salto != NULL ? largo + 1 : largo;
+    memmove(entrada->datos, entrada->datos + consumidos, entrada->usados - consumidos);
+    entrada->usados -= consumidos;
+    return true;
+}
+
+//Espera a que lleguen datos por la entrada estandar y los agrega a la entrada. Si se
+//siguen archivos, espera como mucho INTERVALO_SEGUIMIENTO_MS, para poder revisarlos.
+static void esperar_entrada(entrada_t* entrada, bool con_limite) {
+
+    struct pollfd consulta = { .fd = STDIN_FILENO, .events = POLLIN };
+    int listos = poll(&consulta, 1, con_limite ? INTERVALO_SEGUIMIENTO_MS : -1);
+    if (listos == 0 || (listos < 0 && errno == EINTR)) return;
+    ssize_t leidos = read(STDIN_FILENO, entrada->datos + entrada->usados, TAM_BUFFER - 1 - entrada->usados);
+    if (leidos < 0 && errno == EINTR) return;
+    if (leidos <= 0) entrada->terminada = true;
+    else entrada->usados += (size_t)leidos;
+}
+
+//Procesa lo nuevo de cada archivo seguido. Los que fallan se dejan de seguir.
+static void actualizar_seguidos(lista_t* seguidos, visitantes_t* visitantes, recursos_t* recursos_mas_solicitados) {
+
+    lista_iter_t* iter = lista_iter_crear(seguidos);
+    if (iter == NULL) return;
+    while (!lista_iter_al_final(iter)) {
+        archivo_seguido_t* seguido = lista_iter_ver_actual(iter);
+        if (actualizar_archivo_seguido(seguido, recursos_mas_solicitados, visitantes)) {
+            lista_iter_avanzar(iter);
+            continue;
+        }
+        imprimir_error(SEGUIR_ARCHIVO);
+        dejar_de_seguir(lista_iter_borrar(iter));
+    }
+    lista_iter_destruir(iter);
+}
+
+static void destruir_seguido(void* seguido) {
+
+    dejar_de_seguir(seguido);
+}
+
+void recibir_comandos(visitantes_t* visitantes, recursos_t* recursos_mas_solicitados) {
+
+    lista_t* seguidos = lista_crear();
+    if (seguidos == NULL) return;
+    entrada_t entrada = { .usados = 0, .terminada = false };
     char str[TAM_BUFFER];
-    void* estado;
-    do {
-        estado = fgets(str, TAM_BUFFER, stdin);
-        quitar_caracter_new_line(str);
+    bool seguir = true;
+    while (seguir) {
+        if (tomar_linea(&entrada, str)) {
+            // Antes de cada comando se incorpora lo ultimo de los archivos seguidos.
+            if (!lista_esta_vacia(seguidos)) actualizar_seguidos(seguidos, visitantes, recursos_mas_solicitados);
+            seguir = procesar_entrada_stdin(str, visitantes, recursos_mas_solicitados, seguidos) == 0;
+        } else if (entrada.terminada) {
+            seguir = false;
+        } else {
+            // Se vacia stdout antes de esperar, para que el usuario vea las respuestas anteriores.
+            fflush(stdout);
+            esperar_entrada(&entrada, !lista_esta_vacia(seguidos));
+            if (!lista_esta_vacia(seguidos)) actualizar_seguidos(seguidos, visitantes, recursos_mas_solicitados);
+        }
     }
-    while (estado != NULL && procesar_entrada_stdin(str, visitantes, recursos_mas_solicitados) == 0);
+    lista_destruir(seguidos, destruir_seguido);
+}
+
+//Empieza a seguir el archivo, salvo que ya se lo este siguiendo.
+static bool agregar_seguido(lista_t* seguidos, const char* nombre, visitantes_t* visitantes, recursos_t* recursos_mas_solicitados) {
+
+    lista_iter_t* iter = lista_iter_crear(seguidos);
+    if (iter == NULL) return false;
+    bool repetido = false;
+    while (!repetido && !lista_iter_al_final(iter)) {
+        repetido = archivo_seguido_es(lista_iter_ver_actual(iter), nombre);
+        lista_iter_avanzar(iter);
+    }
+    lista_iter_destruir(iter);
+    if (repetido) return false;
+
+    archivo_seguido_t* seguido = seguir_archivo(nombre, recursos_mas_solicitados, visitantes);
+    if (seguido == NULL) return false;
+    if (!lista_insertar_ultimo(seguidos, seguido)) {
+        dejar_de_seguir(seguido);
+        return false;
+    }
+    return true;
 }
 
 /*FUNCION AUXILIAR*/
@@ -50,42 +167,109 @@ int contar_cantidad_parametros(char** array){
 	return cantidad;
 }
 
+//Expande los patrones recibidos (por ejemplo access*.log) y procesa todos los
+//archivos resultantes en un mismo comando.
+bool agregar_archivos(char** rutas, recursos_t* recursos_mas_solicitados, visitantes_t* visitantes){
+
+	glob_t archivos;
+	memset(&archivos, 0, sizeof(glob_t));
+	int opciones = GLOB_NOCHECK;
+	bool ok = true;
+	for(int i = 0; ok && rutas[i]; i++){
+		ok = glob(rutas[i], opciones, NULL, &archivos) == 0;
+		opciones |= GLOB_APPEND;
+	}
+	if(ok) ok = procesar_logs(archivos.gl_pathv, archivos.gl_pathc, recursos_mas_solicitados, visitantes);
+	globfree(&archivos);
+	return ok;
+}
+
 //Funcion encargada de procesar lo que ingresa el usuario en entrada standard.
 //Segun el comando que ingrese, efectua dicha operacion.
 //Devuelve un entero que representa el estado de la ejecucion de la funcion.
-int procesar_entrada_stdin(char* linea_entrada, abb_t* visitantes, hash_t* recursos_mas_solicitados){
+int procesar_entrada_stdin(char* linea_entrada, visitantes_t* visitantes, recursos_t* recursos_mas_solicitados, lista_t* seguidos){
 
+	ESTADISTICAS_INICIO(inicio_comando);
 	char** input = split(linea_entrada,' ');
+	ESTADISTICAS_REGISTRAR(MEDICION_SPLIT, inicio_comando);
 	int indice_corte = 0;
+	medicion_t medicion = MEDICION_OTROS_COMANDOS;
 	if(strcmp(input[0],AGREGAR_ARCHIVO) == 0){
-		if(contar_cantidad_parametros(input) != CANT_PARAM_AGREGAR || !procesar_log(input[1],recursos_mas_solicitados, visitantes)){
+		medicion = MEDICION_AGREGAR_ARCHIVO;
+		if(contar_cantidad_parametros(input) < CANT_PARAM_AGREGAR || !agregar_archivos(&input[1], recursos_mas_solicitados, visitantes)){
             imprimir_error(AGREGAR_ARCHIVO);
             indice_corte = -1;
 		}
 	}
 	else if(strcmp(input[0],VISITADOS)==0){
-		if(contar_cantidad_parametros(input)==CANT_PARAM_VISITADOS){
-			mostrar_mas_visitados(recursos_mas_solicitados, atoi(input[1]));
-		}
-		else{
+		medicion = MEDICION_VER_MAS_VISITADOS;
+		if(contar_cantidad_parametros(input) != CANT_PARAM_VISITADOS || !mostrar_mas_visitados(recursos_mas_solicitados, atoi(input[1]))){
 			imprimir_error(VISITADOS);
 			indice_corte = -1;
 		}
 	}
 	else if(strcmp(input[0],VISITANTES)==0){
-		if(contar_cantidad_parametros(input) == CANT_PARAM_VISITANTES){
-			mostrar_visitantes(visitantes, input[1], input[2]);
-		}
-		else {
+		medicion = MEDICION_VER_VISITANTES;
+		int cantidad_parametros = contar_cantidad_parametros(input);
+		if((cantidad_parametros != CANT_PARAM_VISITANTES && cantidad_parametros != CANT_PARAM_VISITANTES_CIDR)
+		   || !mostrar_visitantes(visitantes, input[1], input[2])){
 			imprimir_error(VISITANTES);
 			indice_corte = -1;
 		}
 	}
+	else if(strcmp(input[0],GUARDAR_ESTADO)==0){
+		if(contar_cantidad_parametros(input) != CANT_PARAM_ESTADO || !guardar_estado(input[1], recursos_mas_solicitados, visitantes)){
+			imprimir_error(GUARDAR_ESTADO);
+			indice_corte = -1;
+		}
+	}
+	else if(strcmp(input[0],CARGAR_ESTADO)==0){
+		if(contar_cantidad_parametros(input) != CANT_PARAM_ESTADO || !cargar_estado(input[1], recursos_mas_solicitados, visitantes)){
+			imprimir_error(CARGAR_ESTADO);
+			indice_corte = -1;
+		}
+	}
+	else if(strcmp(input[0],CONTAR_VISITANTES)==0){
+		int cantidad_parametros = contar_cantidad_parametros(input);
+		// Sin parametros, input[1] es el NULL final y input[2] ya no es parte del arreglo.
+		char* ip_fin = cantidad_parametros == CANT_PARAM_CONTAR_VISITANTES_RANGO ? input[2] : NULL;
+		if(cantidad_parametros > CANT_PARAM_CONTAR_VISITANTES_RANGO || !mostrar_cantidad_visitantes(visitantes, input[1], ip_fin)){
+			imprimir_error(CONTAR_VISITANTES);
+			indice_corte = -1;
+		}
+	}
+	else if(strcmp(input[0],VISITADOS_ENTRE)==0){
+		if(contar_cantidad_parametros(input) != CANT_PARAM_VISITADOS_ENTRE || !mostrar_mas_visitados_entre(recursos_mas_solicitados, atoi(input[1]), input[2], input[3])){
+			imprimir_error(VISITADOS_ENTRE);
+			indice_corte = -1;
+		}
+	}
+	else if(strcmp(input[0],VISITANTES_ENTRE)==0){
+		if(contar_cantidad_parametros(input) != CANT_PARAM_VISITANTES_ENTRE || !mostrar_visitantes_entre(recursos_mas_solicitados, visitantes, input[1], input[2])){
+			imprimir_error(VISITANTES_ENTRE);
+			indice_corte = -1;
+		}
+	}
+	else if(strcmp(input[0],SEGUIR_ARCHIVO)==0){
+		medicion = MEDICION_AGREGAR_ARCHIVO;
+		if(contar_cantidad_parametros(input) != CANT_PARAM_SEGUIR || !agregar_seguido(seguidos, input[1], visitantes, recursos_mas_solicitados)){
+			imprimir_error(SEGUIR_ARCHIVO);
+			indice_corte = -1;
+		}
+	}
+	else if(strcmp(input[0],ESTADISTICAS)==0){
+		if(contar_cantidad_parametros(input) != CANT_PARAM_ESTADISTICAS || !estadisticas_imprimir(stdout)){
+			imprimir_error(ESTADISTICAS);
+			indice_corte = -1;
+		}
+	}
 	else{
 		imprimir_error(input[0]);
 		indice_corte = -1;
 	}
 	free_strv(input);
+	ESTADISTICAS_REGISTRAR(medicion, inicio_comando);
+	(void)medicion;
 	if(indice_corte >= 0) fprintf(stdout, "OK\n");
 	return indice_corte;
 
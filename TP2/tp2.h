@@ -11,15 +11,20 @@
 #include "lista.h"
 #include "heap.h"
 #include "strutil.h"
-#include "abb.h"
+#include "ip.h"
+#include "visitantes.h"
 #include "DOS.h"
 #include "recursos.h"
-#include "visitantes.h"
+#include "registro.h"
 #include "comandos.h"
+#include "estado.h"
+#include "estadisticas.h"
+#include "salida.h"
 /*****************************************************************************************************/
-//Funcion que recibe un arbol de visitantes y un hash con los recursos mas solicitados del log.
+//Funcion que recibe un conjunto de visitantes y un hash con los recursos mas solicitados del log.
 //Lee por entrada standard lo que ingresa el usuario y llama a la funcion que procesa esos datos.
-void recibir_comandos(abb_t* visitantes, hash_t* recursos);
+//Mientras espera comandos, incorpora lo que se agrega a los archivos seguidos con seguir_archivo.
+void recibir_comandos(visitantes_t* visitantes, recursos_t* recursos);
 
 //Funcion encargada de imprimir un error de comando por stderr.
 void imprimir_error(char* comando);
@@ -28,10 +33,16 @@ void imprimir_error(char* comando);
 //Devuelve esa cantidad.
 int contar_cantidad_parametros(char** array);
 
+//Expande los patrones recibidos (por ejemplo access*.log) y procesa todos los
+//archivos resultantes en un mismo comando.
+//Devuelve false si algun archivo no se pudo abrir.
+bool agregar_archivos(char** rutas, recursos_t* recursos_mas_solicitados, visitantes_t* visitantes);
+
 //Funcion encargada de procesar lo que ingresa el usuario en entrada standard.
-//Segun el comando que ingrese, efectua dicha operacion.
+//Segun el comando que ingrese, efectua dicha operacion. 'seguidos' es la lista de archivos
+//que se estan siguiendo, a la que agrega el comando seguir_archivo.
 //Devuelve un entero que representa el estado de la ejecucion de la funcion.
-int procesar_entrada_stdin(char* linea_entrada, abb_t* arbol_visitantes, hash_t* recursos_mas_solicitados);
+int procesar_entrada_stdin(char* linea_entrada, visitantes_t* visitantes, recursos_t* recursos_mas_solicitados, lista_t* seguidos);
 
 //Recibe una cadena y reemplaza el caracter de salto de linea
 //por el caracter de fin de cadena.
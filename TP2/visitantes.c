@@ -1,31 +1,296 @@
+#include <stdio.h>
+#include <stdlib.h>
 #include "visitantes.h"
+#include "hyperloglog.h"
+#include "estadisticas.h"
+#include "salida.h"
 /********************************************************************************/
 
-int comparar_ips(const char* ip_1, const char* ip_2){
+#define TAM_PRIMER_BLOQUE 1024
+#define TAM_MAXIMO_BLOQUE (1 << 20)
 
-    char** dir_ip1 = split(ip_1, '.');
-    char** dir_ip2 = split(ip_2, '.');
-    int retorno;
-    for(int i=0; i<4; i++){
-        if(atoi(dir_ip1[i]) < atoi(dir_ip2[i])){
-            retorno = -1;
-            break;
-        }
-        else if(atoi(dir_ip1[i]) > atoi(dir_ip2[i])){
-            retorno = 1;
-            break;
-        }
-        else retorno = 0;
+//Arbol de prefijos binario comprimido (Patricia) sobre los bits de la ip, del mas
+//significativo al menos significativo. Cada nodo interno tiene los dos hijos y guarda el
+//prefijo comun a todas las ips de su subarbol; los nodos de un solo hijo se comprimen,
+//asi que la altura no supera los 128 bits y hay exactamente una hoja por ip. Las IPv4
+//comparten los primeros 96 bits, que quedan comprimidos en un solo nodo.
+
+//Encabezado comun a hojas y nodos internos. Las hojas son solo el encabezado.
+typedef struct nodo_visitante {
+    ip_t prefijo;       // Bits comunes del subarbol, con el resto en 0. En una hoja, la ip.
+    uint8_t largo;      // Cantidad de bits del prefijo; BITS_IP en las hojas.
+} nodo_visitante_t;
+
+typedef struct nodo_interno {
+    nodo_visitante_t base;
+    size_t cantidad;                // ips en el subarbol, para contar rangos sin recorrerlos.
+    nodo_visitante_t* hijos[2];     // Segun el bit siguiente al prefijo.
+} nodo_interno_t;
+
+//Los nodos no se liberan de a uno: se reservan de bloques que se liberan al destruir el conjunto.
+typedef struct bloque_nodos {
+    struct bloque_nodos* anterior;
+    size_t usado;
+    size_t capacidad;
+    char datos[];
+} bloque_nodos_t;
+
+struct visitantes {
+    nodo_visitante_t* raiz;
+    size_t cantidad;
+    bloque_nodos_t* bloques;
+    hll_t* aproximacion;    // Solo en modo aproximado; en ese caso el arbol queda vacio.
+};
+
+/*************************** FUNCIONES AUXILIARES DEL ARBOL ***************************/
+
+//Mascara con los primeros 'largo' bits en 1.
+static ip_t mascara(uint8_t largo) {
+
+    return largo == 0 ? 0 : IP_MAXIMA << (BITS_IP - largo);
+}
+
+//Devuelve el bit de la ip en la posicion dada, contando desde el mas significativo.
+static unsigned bit_en(ip_t ip, uint8_t posicion) {
+
+    return (unsigned)(ip >> (BITS_IP - 1 - posicion)) & 1;
+}
+
+//Cantidad de bits iniciales en que coinciden las dos ips.
+static uint8_t largo_comun(ip_t a, ip_t b) {
+
+    ip_t distintos = a ^ b;
+    uint64_t alta = (uint64_t)(distintos >> 64);
+    uint64_t baja = (uint64_t)distintos;
+    if (alta != 0) return (uint8_t)__builtin_clzll(alta);
+    return (uint8_t)(baja != 0 ? 64 + __builtin_clzll(baja) : BITS_IP);
+}
+
+//Mayor ip que puede estar en el subarbol del nodo.
+static ip_t ultima_ip(const nodo_visitante_t* nodo) {
+
+    return nodo->prefijo | ~mascara(nodo->largo);
+}
+
+static size_t cantidad_en(const nodo_visitante_t* nodo) {
+
+    return nodo->largo == BITS_IP ? 1 : ((const nodo_interno_t*)nodo)->cantidad;
+}
+
+//Reserva 'tamanio' bytes (multiplo de 8) del ultimo bloque, agregando uno nuevo si no entra.
+static void* reservar_nodo(visitantes_t* visitantes, size_t tamanio) {
+
+    bloque_nodos_t* bloque = visitantes->bloques;
+    if (bloque == NULL || bloque->capacidad - bloque->usado < tamanio) {
+        size_t capacidad = bloque == NULL ? TAM_PRIMER_BLOQUE : bloque->capacidad * 2;
+        if (capacidad > TAM_MAXIMO_BLOQUE) capacidad = TAM_MAXIMO_BLOQUE;
+        bloque = malloc(sizeof(bloque_nodos_t) + capacidad);
+        if (bloque == NULL) return NULL;
+        ESTADISTICAS_SUMAR(CONTADOR_NODOS_CREADOS, 1);
+        bloque->anterior = visitantes->bloques;
+        bloque->usado = 0;
+        bloque->capacidad = capacidad;
+        visitantes->bloques = bloque;
     }
-    free_strv(dir_ip1);
-    free_strv(dir_ip2);
+    void* nodo = bloque->datos + bloque->usado;
+    bloque->usado += tamanio;
+    return nodo;
+}
+
+/********************************************************************************/
+
+visitantes_t* visitantes_crear(void) {
+
+    visitantes_t* visitantes = malloc(sizeof(visitantes_t));
+    if (visitantes == NULL) return NULL;
+    visitantes->raiz = NULL;
+    visitantes->cantidad = 0;
+    visitantes->bloques = NULL;
+    visitantes->aproximacion = NULL;
+    return visitantes;
+}
+
+visitantes_t* visitantes_crear_aproximado(uint8_t precision) {
+
+    visitantes_t* visitantes = visitantes_crear();
+    if (visitantes == NULL) return NULL;
+    visitantes->aproximacion = hll_crear(precision);
+    if (visitantes->aproximacion == NULL) {
+        free(visitantes);
+        return NULL;
+    }
+    return visitantes;
+}
+
+visitantes_t* visitantes_crear_como(const visitantes_t* modelo) {
 
-    return retorno;
+    if (modelo->aproximacion == NULL) return visitantes_crear();
+    visitantes_t* visitantes = visitantes_crear();
+    if (visitantes == NULL) return NULL;
+    visitantes->aproximacion = hll_crear_como(modelo->aproximacion);
+    if (visitantes->aproximacion == NULL) {
+        free(visitantes);
+        return NULL;
+    }
+    return visitantes;
+}
+
+bool visitantes_es_aproximado(const visitantes_t* visitantes) {
+
+    return visitantes->aproximacion != NULL;
 }
 
-bool imprimir_claves(const char* ip, void* dato1, void* dato2){
-    
-    printf("\t%s\n", ip);
+//Mezcla los bits de la ip (finalizador de splitmix64) para alimentar al HyperLogLog.
+static uint64_t hash_ip(ip_t ip) {
+
+    uint64_t hash = ((uint64_t)ip ^ (uint64_t)(ip >> 64) * 0xC2B2AE3D27D4EB4FULL) + 0x9E3779B97F4A7C15ULL;
+    hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBULL;
+    return hash ^ (hash >> 31);
+}
+
+bool visitantes_guardar(visitantes_t* visitantes, ip_t ip) {
+
+    if (visitantes->aproximacion != NULL) {
+        hll_agregar(visitantes->aproximacion, hash_ip(ip));
+        return true;
+    }
+
+    // Se baja con un puntero al enlace a modificar, recordando los nodos internos del camino
+    // para actualizar sus cantidades solo si la ip no estaba.
+    nodo_visitante_t** enlace = &visitantes->raiz;
+    nodo_interno_t* camino[BITS_IP];
+    size_t largo_camino = 0;
+    while (*enlace != NULL && (ip & mascara((*enlace)->largo)) == (*enlace)->prefijo) {
+        if ((*enlace)->largo == BITS_IP) return true;
+        nodo_interno_t* interno = (nodo_interno_t*)*enlace;
+        camino[largo_camino++] = interno;
+        enlace = &interno->hijos[bit_en(ip, interno->base.largo)];
+    }
+
+    nodo_visitante_t* hoja = reservar_nodo(visitantes, sizeof(nodo_visitante_t));
+    if (hoja == NULL) return false;
+    hoja->prefijo = ip;
+    hoja->largo = BITS_IP;
+    if (*enlace == NULL) {
+        *enlace = hoja;
+    } else {
+        // El prefijo del nodo difiere de la ip: se lo separa en el primer bit distinto.
+        nodo_visitante_t* nodo = *enlace;
+        nodo_interno_t* interno = reservar_nodo(visitantes, sizeof(nodo_interno_t));
+        if (interno == NULL) return false;
+        uint8_t comun = largo_comun(ip, nodo->prefijo);
+        interno->base.prefijo = ip & mascara(comun);
+        interno->base.largo = comun;
+        interno->cantidad = cantidad_en(nodo) + 1;
+        unsigned lado = bit_en(ip, comun);
+        interno->hijos[lado] = hoja;
+        interno->hijos[1 - lado] = nodo;
+        *enlace = &interno->base;
+    }
+    for (size_t i = 0; i < largo_camino; i++) camino[i]->cantidad++;
+    ESTADISTICAS_SUMAR(CONTADOR_VISITANTES_GUARDADOS, 1);
+    visitantes->cantidad++;
     return true;
 }
 
+bool visitantes_guardar_ordenadas(visitantes_t* visitantes, const ip_t* ips, size_t cantidad) {
+
+    for (size_t i = 0; i < cantidad; i++) {
+        if (!visitantes_guardar(visitantes, ips[i])) return false;
+    }
+    return true;
+}
+
+//Guarda en destino las ips de las hojas del subarbol.
+static bool guardar_subarbol(visitantes_t* destino, const nodo_visitante_t* nodo) {
+
+    if (nodo == NULL) return true;
+    if (nodo->largo == BITS_IP) return visitantes_guardar(destino, nodo->prefijo);
+    const nodo_interno_t* interno = (const nodo_interno_t*)nodo;
+    return guardar_subarbol(destino, interno->hijos[0]) && guardar_subarbol(destino, interno->hijos[1]);
+}
+
+bool visitantes_fusionar(visitantes_t* destino, const visitantes_t* origen) {
+
+    if (origen->aproximacion != NULL) {
+        // Un conjunto aproximado no guarda sus ips, asi que solo se puede fusionar en otro aproximado.
+        if (destino->aproximacion == NULL) return false;
+        hll_fusionar(destino->aproximacion, origen->aproximacion);
+        return true;
+    }
+    return guardar_subarbol(destino, origen->raiz);
+}
+
+bool visitantes_pertenece(const visitantes_t* visitantes, ip_t ip) {
+
+    const nodo_visitante_t* actual = visitantes->raiz;
+    while (actual != NULL && (ip & mascara(actual->largo)) == actual->prefijo) {
+        if (actual->largo == BITS_IP) return true;
+        actual = ((const nodo_interno_t*)actual)->hijos[bit_en(ip, actual->largo)];
+    }
+    return false;
+}
+
+size_t visitantes_cantidad(const visitantes_t* visitantes) {
+
+    if (visitantes->aproximacion != NULL) return hll_estimar(visitantes->aproximacion);
+    return visitantes->cantidad;
+}
+
+//Recorre en orden solo los subarboles cuyo rango de ips se cruza con [inicio, fin].
+//Devuelve false si visitar pidio cortar el recorrido.
+static bool recorrer_rango(const nodo_visitante_t* nodo, ip_t inicio, ip_t fin, visitantes_visitar_t visitar, void* extra) {
+
+    if (nodo == NULL || ultima_ip(nodo) < inicio || nodo->prefijo > fin) return true;
+    if (nodo->largo == BITS_IP) return visitar(nodo->prefijo, extra);
+    const nodo_interno_t* interno = (const nodo_interno_t*)nodo;
+    return recorrer_rango(interno->hijos[0], inicio, fin, visitar, extra)
+        && recorrer_rango(interno->hijos[1], inicio, fin, visitar, extra);
+}
+
+//Cuenta las ips del subarbol en [inicio, fin]. Los subarboles contenidos en el rango
+//aportan su cantidad sin recorrerlos, asi que solo se bajan los dos caminos de los bordes.
+static size_t contar_rango(const nodo_visitante_t* nodo, ip_t inicio, ip_t fin) {
+
+    if (nodo == NULL || ultima_ip(nodo) < inicio || nodo->prefijo > fin) return 0;
+    if (inicio <= nodo->prefijo && ultima_ip(nodo) <= fin) return cantidad_en(nodo);
+    const nodo_interno_t* interno = (const nodo_interno_t*)nodo;
+    return contar_rango(interno->hijos[0], inicio, fin) + contar_rango(interno->hijos[1], inicio, fin);
+}
+
+size_t visitantes_contar_rango(const visitantes_t* visitantes, ip_t inicio, ip_t fin) {
+
+    return contar_rango(visitantes->raiz, inicio, fin);
+}
+
+void visitantes_recorrer_rango(const visitantes_t* visitantes, ip_t inicio, ip_t fin, visitantes_visitar_t visitar, void* extra) {
+
+    if (visitar == NULL) return;
+    recorrer_rango(visitantes->raiz, inicio, fin, visitar, extra);
+}
+
+void visitantes_recorrer(const visitantes_t* visitantes, visitantes_visitar_t visitar, void* extra) {
+
+    visitantes_recorrer_rango(visitantes, 0, IP_MAXIMA, visitar, extra);
+}
+
+void visitantes_destruir(visitantes_t* visitantes) {
+
+    if (visitantes == NULL) return;
+    while (visitantes->bloques != NULL) {
+        bloque_nodos_t* anterior = visitantes->bloques->anterior;
+        free(visitantes->bloques);
+        visitantes->bloques = anterior;
+    }
+    hll_destruir(visitantes->aproximacion);
+    free(visitantes);
+}
+
+bool imprimir_visitante(ip_t ip, void* salida) {
+
+    salida_caracter(salida, '\t');
+    salida_ip(salida, ip);
+    salida_caracter(salida, '\n');
+    return true;
+}
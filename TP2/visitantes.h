@@ -1,15 +1,71 @@
 #ifndef ALGOS_GITHUB_VISITANTES_H
 #define ALGOS_GITHUB_VISITANTES_H
 
-#include "tp2.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "ip.h"
+
+//Conjunto ordenado de direcciones ip, implementado como un arbol de prefijos binario
+//comprimido (Patricia) sobre los bits de las ip_t, con la cantidad de ips de cada subarbol.
+//Los rangos y los bloques CIDR se recorren en O(128 + resultado) y se cuentan en O(128);
+//entre IPv4 la altura es a lo sumo 33, porque el prefijo comun de 96 bits va en un nodo.
+//En modo aproximado no se guardan las ips: solo se estima la cantidad de ips distintas
+//con un HyperLogLog de memoria fija, y los recorridos no visitan nada.
+typedef struct visitantes visitantes_t;
+
+//Funcion que se aplica a cada ip en un recorrido. Si devuelve false, se corta el recorrido.
+typedef bool (*visitantes_visitar_t)(ip_t ip, void* extra);
 /************************************************************************************/
-//Funcion de comparacion de IPS
-//Devuelve 0 si son iguales, 1 si el segundo parametro es mayor al primero,
-//-1 si el primer parametro es mayor al segundo.(Los valores de retono son por
-//un tema de convencion a la hora de imprmir las ip's en orden creciente).
-int comparar_ips(const char* ip_1, const char* ip_2);
-
-//Funcion que imprime una ip dada por parametro.
-bool imprimir_claves(const char* ip, void* dato1, void* dato2);
+
+//Crea un conjunto de visitantes vacio.
+//Post: devuelve el conjunto, NULL si fallo la memoria.
+visitantes_t* visitantes_crear(void);
+
+//Crea un conjunto aproximado vacio, con un HyperLogLog de la precision dada.
+//Post: devuelve el conjunto, NULL si la precision es invalida o fallo la memoria.
+visitantes_t* visitantes_crear_aproximado(uint8_t precision);
+
+//Crea un conjunto vacio del mismo tipo que 'modelo' (exacto o aproximado con igual precision).
+visitantes_t* visitantes_crear_como(const visitantes_t* modelo);
+
+//Devuelve true si el conjunto solo estima la cantidad de visitantes.
+bool visitantes_es_aproximado(const visitantes_t* visitantes);
+
+//Agrega la ip al conjunto. Si ya pertenecia no hace nada.
+//Post: devuelve false si fallo la memoria.
+bool visitantes_guardar(visitantes_t* visitantes, ip_t ip);
+
+//Agrega las 'cantidad' ips de un arreglo ordenado de forma creciente.
+//Post: devuelve false si fallo la memoria.
+bool visitantes_guardar_ordenadas(visitantes_t* visitantes, const ip_t* ips, size_t cantidad);
+
+//Agrega al conjunto destino todas las ips del conjunto origen. Un origen exacto se
+//puede fusionar en un destino aproximado, pero no al reves.
+//Pre: si los dos son aproximados, destino se creo con visitantes_crear_como(origen) o viceversa.
+//Post: devuelve false si fallo la memoria o si origen es aproximado y destino no.
+bool visitantes_fusionar(visitantes_t* destino, const visitantes_t* origen);
+
+//Devuelve true si la ip pertenece al conjunto.
+bool visitantes_pertenece(const visitantes_t* visitantes, ip_t ip);
+
+//Devuelve la cantidad de ips distintas del conjunto (una estimacion en modo aproximado).
+size_t visitantes_cantidad(const visitantes_t* visitantes);
+
+//Aplica visitar, en orden creciente, a cada ip del conjunto comprendida entre inicio y fin (inclusive).
+void visitantes_recorrer_rango(const visitantes_t* visitantes, ip_t inicio, ip_t fin, visitantes_visitar_t visitar, void* extra);
+
+//Devuelve la cantidad de ips del conjunto comprendidas entre inicio y fin (inclusive),
+//sin recorrerlas. En modo aproximado devuelve 0.
+size_t visitantes_contar_rango(const visitantes_t* visitantes, ip_t inicio, ip_t fin);
+
+//Aplica visitar, en orden creciente, a todas las ips del conjunto.
+void visitantes_recorrer(const visitantes_t* visitantes, visitantes_visitar_t visitar, void* extra);
+
+//Destruye el conjunto.
+void visitantes_destruir(visitantes_t* visitantes);
+
+//Funcion que imprime una ip dada por parametro en la salida_t* recibida.
+bool imprimir_visitante(ip_t ip, void* salida);
 
 #endif //ALGOS_GITHUB_VISITANTES_H